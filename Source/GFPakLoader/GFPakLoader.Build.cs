@@ -48,6 +48,7 @@ public class GFPakLoader : ModuleRules
 			PrivateDependencyModuleNames.Add("UnrealEd");
 			PrivateDependencyModuleNames.Add( "TypedElementRuntime");
 			PrivateDependencyModuleNames.Add( "ContentBrowserData");
+			PrivateDependencyModuleNames.Add( "DirectoryWatcher");
 		}
 
 		DynamicallyLoadedModuleNames.AddRange(
@@ -98,4 +98,15 @@ bool FPakGenerateFilenameMap::Visit(const TCHAR* FilenameOrDirectory, bool bIsDi
 	return false;
 }
 
-
+bool FDirectoryStatLister::Visit(const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+{
+	if (StatData.bIsDirectory)
+	{
+		Directories.Emplace(FilenameOrDirectory, StatData.ModificationTime);
+	}
+	else
+	{
+		Files.Add(FilenameOrDirectory);
+	}
+	return true;
+}
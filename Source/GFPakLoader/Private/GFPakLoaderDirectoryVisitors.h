@@ -84,3 +84,13 @@ public:
 
 	TMap<FName, TSharedPtr<const FGFPakFilenameMap>> PakFilenamesMap;
 };
+
+
+class FDirectoryStatLister : public IPlatformFile::FDirectoryStatVisitor
+{
+public:
+	virtual bool Visit(const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) override;
+
+	TArray<FString> Files;
+	TArray<TPair<FString, FDateTime>> Directories;
+};
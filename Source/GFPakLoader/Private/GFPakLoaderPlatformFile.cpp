@@ -7,11 +7,13 @@
 #include "GFPakLoaderSubsystem.h"
 #include "IPlatformFilePak.h"
 
-FString FGFPakLoaderPlatformFile::GetPakAdjustedFilename(const TCHAR* OriginalFilename, bool* bFoundInPak)
+FString FGFPakLoaderPlatformFile::GetPakAdjustedFilename(const TCHAR* OriginalFilename, bool* bFoundInPak, bool bIsOpeningFile)
 {
 	if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
 	{
 		FString Filename;
+		// The Pak Plugins registered on demand are mounted by the subsystem before their packages are loaded, not here, as mounting is too heavy for a file access.
+		// See UGFPakLoaderSettings::bMountPakPluginsOnDemand
 		if (UGFPakPlugin* Plugin = Subsystem->FindMountedPakContainingFile(OriginalFilename, &Filename))
 		{
 			UE_LOG(LogGFPakLoader, VeryVerbose, TEXT(" ... GetPakAdjustedFilename FOUND ( `%s` ) => `%s`"), OriginalFilename, *Filename)
@@ -19,6 +21,10 @@ FString FGFPakLoaderPlatformFile::GetPakAdjustedFilename(const TCHAR* OriginalFi
 			{
 				*bFoundInPak = true;
 			}
+			if (bIsOpeningFile) // The content of the Pak Plugin is actually used, see UGFPakLoaderSettings::bActivateGameFeaturesOnFirstAccess
+			{
+				Plugin->NotifyContentAccessed();
+			}
 			return Filename;
 		}
 	}
@@ -63,18 +69,19 @@ void FGFPakLoaderPlatformFile::Tick()
 
 /**
  * Macro to call the given Function on the right PlatformFile, depending if the file is within a pak or not.
- * ex: CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(bool, false, FileExists(Filename))
+ * ex: CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX(IFileHandle*, nullptr, true, OpenRead(Filename, bAllowWrite))
  * todo: Currently we are trying first to call the function in the PakPlatform file and if not successful, call it in the Inner platform file which is not the most efficient. Check if this can be improved
  * todo: also do not bother if no paks are loaded, go straight to the Lowerlevel?
  * @param Type The type of the return value of the Function
  * @param DefaultValue The DefaultValue to return if no PlatformFile is valid
+ * @param bIsOpeningFile Passed to GetPakAdjustedFilename, true if the Function opens the file to read its content
  * @param Function The complete function call to pass to PlatformFile->
  */
-#define CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(Type, DefaultValue, Function) \
+#define CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX(Type, DefaultValue, bIsOpeningFile, Function) \
 	Type Value = DefaultValue; \
 	if (IPlatformFile* PlatformFile = GetPlatformFile(Filename)) \
 	{ \
-		FString AdjustedFilename = GetPakAdjustedFilename(Filename); \
+		FString AdjustedFilename = GetPakAdjustedFilename(Filename, nullptr, bIsOpeningFile); \
 		Filename = *AdjustedFilename; \
 		Value = PlatformFile->Function; \
 		if (Value == DefaultValue && LowerLevel != nullptr && PakPlatformFile == PlatformFile) \
@@ -84,6 +91,13 @@ void FGFPakLoaderPlatformFile::Tick()
 	} \
 	return Value;
 
+/**
+ * Same as CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX, for a Function which does not open the file.
+ * ex: CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(bool, false, FileExists(Filename))
+ */
+#define CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(Type, DefaultValue, Function) \
+	CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX(Type, DefaultValue, false, Function)
+
 bool FGFPakLoaderPlatformFile::FileExists(const TCHAR* Filename)
 {
 	CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(bool, false, FileExists(Filename))
@@ -136,7 +150,7 @@ IFileHandle* FGFPakLoaderPlatformFile::OpenRead(const TCHAR* Filename, bool bAll
 	UE_LOG(LogGFPakLoader, VeryVerbose, TEXT(" ... FGFPakLoaderPlatformFile::OpenRead ( `%s` )"), Filename)
 	// todo: as the macro calls GetPakAdjustedFilename which ends up calling FindMountedPakContainingFile,
 	// we are already have a handle of the right plugin containing the file, could we somehow use it here and in the other functions? 
-	CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE(IFileHandle*, nullptr, OpenRead(Filename, bAllowWrite))
+	CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX(IFileHandle*, nullptr, true, OpenRead(Filename, bAllowWrite))
 }
 IAsyncReadFileHandle* FGFPakLoaderPlatformFile::OpenAsyncRead(const TCHAR* Filename)
 {
@@ -150,7 +164,7 @@ IAsyncReadFileHandle* FGFPakLoaderPlatformFile::OpenAsyncRead(const TCHAR* Filen
 	if (IPlatformFile* PlatformFile = GetPlatformFile(Filename))
 	{
 		bool bFoundInPak;
-		FString AdjustedFilename = GetPakAdjustedFilename(Filename, &bFoundInPak);
+		FString AdjustedFilename = GetPakAdjustedFilename(Filename, &bFoundInPak, true);
 		Filename = *AdjustedFilename;
 		
 		if (bFoundInPak && PakPlatformFile == PlatformFile)
@@ -417,4 +431,5 @@ void FGFPakLoaderPlatformFile::SetSandboxEnabled(bool bInEnabled)
 	}
 }
 
-#undef CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE
\ No newline at end of file
+#undef CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE
+#undef CALL_PAK_PLATFORM_FILE_FIRST_ON_FILE_EX
\ No newline at end of file
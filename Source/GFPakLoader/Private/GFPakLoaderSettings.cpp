@@ -21,6 +21,14 @@ void UGFPakLoaderSettings::PostEditChangeProperty(FPropertyChangedEvent& Propert
 	{
 		SetPakLoadPath(StartupPakLoadDirectory.Path);
 	}
+	if(PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UGFPakLoaderSettings, StartupPakLoadDirectory) ||
+		PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UGFPakLoaderSettings, bWatchPakLoadPath))
+	{
+		if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
+		{
+			Subsystem->OnWatchPakLoadPathChanged();
+		}
+	}
 	if(PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UGFPakLoaderSettings, bEnsureWorldIsLoadedInMemoryBeforeLoadingMap))
 	{
 		if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
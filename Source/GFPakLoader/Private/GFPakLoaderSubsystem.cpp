@@ -6,16 +6,28 @@
 #include "GFPakLoaderLog.h"
 #include "GFPakLoaderPlatformFile.h"
 #include "GFPakLoaderSettings.h"
-#include "Algo/Find.h"
+#include "Algo/AllOf.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
+#include "AssetRegistry/ARFilter.h"
 #include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/PathViews.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 #include "UObject/AssetRegistryTagsContext.h"
 
 #if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
 #include "Selection.h"
 #endif
 
@@ -60,7 +72,44 @@ void UGFPakLoaderSubsystem::Deinitialize()
 {
 	bIsShuttingDown = true;
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("Deinitializing the UGFPakLoaderSubsystem..."))
+	// Saved before the listeners get a chance to unmount the PakPlugins
+	if (bStarted && GetPakLoaderSettings()->bRestorePreviousSession)
+	{
+		SaveSessionSnapshot();
+	}
 	OnSubsystemShuttingDownDelegate.Broadcast();
+	
+	FTSTicker::GetCoreTicker().RemoveTicker(GameFeatureActivationsTickHandle);
+	GameFeatureActivationsTickHandle.Reset();
+	FTSTicker::GetCoreTicker().RemoveTicker(PakPluginsEvictionTickHandle);
+	PakPluginsEvictionTickHandle.Reset();
+	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+	FWorldDelegates::OnWorldCleanup.RemoveAll(this);
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+	PackagesReferencedByLoadedWorlds.Empty();
+	bPackagesReferencedByLoadedWorldsDirty = true;
+	PakPluginsEvictionStates.Empty();
+	FTSTicker::GetCoreTicker().RemoveTicker(ScheduledMountsTickHandle);
+	ScheduledMountsTickHandle.Reset();
+	for (TArray<FScheduledMount>& Mounts : ScheduledMounts)
+	{
+		for (FScheduledMount& ScheduledMount : Mounts)
+		{
+			ScheduledMount.CompleteDelegate.ExecuteIfBound(false, {});
+		}
+		Mounts.Empty();
+	}
+	RecentMounts.Empty();
+	for (FScheduledGameFeatureActivation& ScheduledActivation : PendingGameFeatureActivations)
+	{
+		ScheduledActivation.CompleteDelegate.ExecuteIfBound(false, {});
+	}
+	PendingGameFeatureActivations.Empty();
+	InFlightGameFeatureActivations.Empty();
+	FailedGameFeatureActivations.Empty();
+	bHasScheduledGameFeatureActivations = false;
 
 	// todo: there might still be some multithreading issues as we are deinitializing the PakPlugins outside of the GameFeaturesPakPluginsLock Write lock (which is needed to avoid deadlocks)
 	// Each PakPlugin should have its own lock to access its content as it can be accessed from the AsyncLoadingThread via FGFPakLoaderPlatformFile
@@ -74,6 +123,34 @@ void UGFPakLoaderSubsystem::Deinitialize()
 	{
 		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_Write);
 		GameFeaturesPakPlugins.Empty();
+		GameFeaturesPakPluginsByDirectory.Empty();
+	}
+	{
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_Write);
+		for (TArray<UGFPakPlugin*>& PakPlugins : PakPluginsByStatus)
+		{
+			PakPlugins.Empty();
+		}
+		MountedPakPluginsInOrder.Empty();
+		MountedPakPluginsByPriority.Empty();
+	}
+	{
+		FScopeLock Lock(&RemountCacheMutex);
+		RemountCache.Empty();
+	}
+	{
+		FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+		PakPluginDirectoriesInfo.Empty();
+	}
+	StopWatchingPakLoadPath();
+	{
+		FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+		PakPluginsByName.Empty();
+		PakPluginsByMountPointName.Empty();
+		OnDemandPakPluginsByMountPointName.Empty();
+#if WITH_EDITOR
+		PakPluginsByMountPointAboutToBeMounted.Empty();
+#endif
 	}
 	
 	// We restore the original delegate. See UGFPakLoaderSubsystem::Initialize for more explanations
@@ -81,6 +158,9 @@ void UGFPakLoaderSubsystem::Deinitialize()
 	
 	FPackageName::OnContentPathMounted().RemoveAll(this);
 	FPackageName::OnContentPathDismounted().RemoveAll(this);
+	
+	FCoreDelegates::OnSyncLoadPackage.RemoveAll(this);
+	FCoreDelegates::OnAsyncLoadPackage.RemoveAll(this);
 
 	FCoreUObjectDelegates::PreLoadMapWithContext.RemoveAll(this);
 	
@@ -128,15 +208,8 @@ void UGFPakLoaderSubsystem::AddPakPluginFolder(const FString& InPakPluginFolder,
 	for (const FString& PluginPath : DirectoryLister.Directories)
 	{
 		// First, we ignore DLC folders starting with the IgnorePakWithPrefix, useful for testing
-		const FString PluginFolderName = FPaths::GetBaseFilename(PluginPath);
-		if (!GetPakLoaderSettings()->IgnorePakWithPrefix.IsEmpty() && PluginFolderName.StartsWith(GetPakLoaderSettings()->IgnorePakWithPrefix))
+		if (IsIgnoredPakPluginFolder(PluginPath))
 		{
-			if (!IgnoredPluginPaths.Contains(PluginPath))
-			{
-				UE_LOG(LogGFPakLoader, Warning, TEXT("Ignoring the potential plugin located at '%s' because its folder name '%s' starts with '%s', as per the IgnorePakWithPrefix of the Pak Loader Settings"),
-				*FPaths::ConvertRelativePathToFull(PluginPath), *PluginFolderName, *GetPakLoaderSettings()->IgnorePakWithPrefix)
-			}
-			IgnoredPluginPaths.Add(PluginPath);
 			continue;
 		}
 		
@@ -163,9 +236,26 @@ void UGFPakLoaderSubsystem::AddPakPluginFolder(const FString& InPakPluginFolder,
 		NbAddedPlugins, NbExistingPlugins, NbFailed)
 }
 
+bool UGFPakLoaderSubsystem::IsIgnoredPakPluginFolder(const FString& PakPluginDirectory)
+{
+	const FString PluginFolderName = FPaths::GetBaseFilename(PakPluginDirectory);
+	if (!GetPakLoaderSettings()->IgnorePakWithPrefix.IsEmpty() && PluginFolderName.StartsWith(GetPakLoaderSettings()->IgnorePakWithPrefix))
+	{
+		if (!IgnoredPluginPaths.Contains(PakPluginDirectory))
+		{
+			UE_LOG(LogGFPakLoader, Warning, TEXT("Ignoring the potential plugin located at '%s' because its folder name '%s' starts with '%s', as per the IgnorePakWithPrefix of the Pak Loader Settings"),
+			*FPaths::ConvertRelativePathToFull(PakPluginDirectory), *PluginFolderName, *GetPakLoaderSettings()->IgnorePakWithPrefix)
+		}
+		IgnoredPluginPaths.Add(PakPluginDirectory);
+		return true;
+	}
+	return false;
+}
+
 UGFPakPlugin* UGFPakLoaderSubsystem::GetOrAddPakPlugin(const FString& InPakPluginPath, bool& bIsNewlyAdded)
 {
 	FString PakPluginPath = FPaths::ConvertRelativePathToFull(InPakPluginPath);
+	FPaths::NormalizeDirectoryName(PakPluginPath); // Same normalization as UGFPakPlugin::SetPakPluginDirectory, so the path can be used with GameFeaturesPakPluginsByDirectory
 	if (!IsReady())
 	{
 		bIsNewlyAdded = false;
@@ -176,25 +266,29 @@ UGFPakPlugin* UGFPakLoaderSubsystem::GetOrAddPakPlugin(const FString& InPakPlugi
 	UGFPakPlugin* PakPlugin;
 	{
 		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_ReadOnly);
-		UGFPakPlugin** ExistingPakPlugin = Algo::FindByPredicate(GameFeaturesPakPlugins,
-			[&PakPluginPath](const UGFPakPlugin* PakPlugin)
-			{
-				return FPaths::IsSamePath(PakPlugin->GetPakPluginDirectory(), PakPluginPath);
-			});
-
-		bIsNewlyAdded = !ExistingPakPlugin;
-		if (!bIsNewlyAdded)
+		if (UGFPakPlugin* ExistingPakPlugin = FindPakPluginByDirectory(PakPluginPath))
 		{
-			return *ExistingPakPlugin;
+			bIsNewlyAdded = false;
+			return ExistingPakPlugin;
 		}
 	}
 	{
 		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_Write);
+		if (UGFPakPlugin* ExistingPakPlugin = FindPakPluginByDirectory(PakPluginPath)) // It might have been added in between the two locks
+		{
+			bIsNewlyAdded = false;
+			return ExistingPakPlugin;
+		}
+		bIsNewlyAdded = true;
 		
 		PakPlugin = NewObject<UGFPakPlugin>(this);
 		PakPlugin->SetPakPluginDirectory(PakPluginPath);
 	
 		GameFeaturesPakPlugins.Emplace(PakPlugin); // need to be done here as the UGFPakLoaderSubsystem::RegisterMountPoint might get triggered on loading
+		GameFeaturesPakPluginsByDirectory.Add(PakPluginPath, PakPlugin);
+		
+		FRWScopeLock StatusLock(PakPluginsByStatusLock, SLT_Write);
+		PakPluginsByStatus[static_cast<int32>(PakPlugin->GetStatus())].Add(PakPlugin);
 	}
 	
 	PakPlugin->OnStatusChanged().AddDynamic(this, &ThisClass::PakPluginStatusChanged);
@@ -212,6 +306,330 @@ UGFPakPlugin* UGFPakLoaderSubsystem::GetOrAddPakPlugin(const FString& InPakPlugi
 	return nullptr;
 }
 
+FGFPakPluginDirectoryInfo UGFPakLoaderSubsystem::GetPakPluginDirectoryInfo(const FString& PakPluginDirectory)
+{
+	TOptional<FGFPakPluginDirectoryInfo> CachedDirectoryInfo;
+	{
+		FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+		if (const FGFPakPluginDirectoryInfo* DirectoryInfo = PakPluginDirectoriesInfo.Find(PakPluginDirectory))
+		{
+			CachedDirectoryInfo = *DirectoryInfo;
+		}
+	}
+	if (CachedDirectoryInfo.IsSet() && CachedDirectoryInfo->IsUpToDate()) // the stat calls are done outside of the lock
+	{
+		return CachedDirectoryInfo.GetValue();
+	}
+	
+	FGFPakPluginDirectoryInfo DirectoryInfo = FGFPakPluginDirectoryInfo::FromDirectory(PakPluginDirectory);
+	{
+		FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+		if (DirectoryInfo.bDirectoryExists)
+		{
+			PakPluginDirectoriesInfo.Add(PakPluginDirectory, DirectoryInfo);
+		}
+		else
+		{
+			PakPluginDirectoriesInfo.Remove(PakPluginDirectory);
+		}
+	}
+	return DirectoryInfo;
+}
+
+void UGFPakLoaderSubsystem::AddPakRemountData(FPakRemountData&& RemountData)
+{
+	const int32 RemountCacheSize = GetPakLoaderSettings()->RemountCacheSize;
+	if (RemountCacheSize <= 0 || bIsShuttingDown)
+	{
+		return;
+	}
+	
+	const FFileStatData PakFileStat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*RemountData.PakFilePath);
+	if (!PakFileStat.bIsValid)
+	{
+		return;
+	}
+	RemountData.PakFileSize = PakFileStat.FileSize;
+	RemountData.PakFileTimestamp = PakFileStat.ModificationTime;
+	
+	FScopeLock Lock(&RemountCacheMutex);
+	RemountCache.RemoveAll([&RemountData](const FPakRemountData& CachedRemountData) { return CachedRemountData.PakFilePath == RemountData.PakFilePath; });
+	RemountCache.Add(MoveTemp(RemountData));
+	if (RemountCache.Num() > RemountCacheSize)
+	{
+		RemountCache.RemoveAt(0, RemountCache.Num() - RemountCacheSize);
+	}
+}
+
+TOptional<UGFPakLoaderSubsystem::FPakRemountData> UGFPakLoaderSubsystem::TakePakRemountData(const FString& PakFilePath)
+{
+	TOptional<FPakRemountData> RemountData;
+	{
+		FScopeLock Lock(&RemountCacheMutex);
+		const int32 Index = RemountCache.IndexOfByPredicate([&PakFilePath](const FPakRemountData& CachedRemountData) { return CachedRemountData.PakFilePath == PakFilePath; });
+		if (Index == INDEX_NONE)
+		{
+			return {};
+		}
+		RemountData = MoveTemp(RemountCache[Index]);
+		RemountCache.RemoveAt(Index);
+	}
+	
+	const FFileStatData PakFileStat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*PakFilePath);
+	if (!PakFileStat.bIsValid || PakFileStat.FileSize != RemountData->PakFileSize || PakFileStat.ModificationTime != RemountData->PakFileTimestamp)
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("  The pak '%s' changed since it was unmounted, the Remount Cache data are discarded"), *PakFilePath)
+		return {};
+	}
+	return RemountData;
+}
+
+void UGFPakLoaderSubsystem::OnPakPluginStatusSet(UGFPakPlugin* PakPlugin, EGFPakLoaderStatus OldStatus, EGFPakLoaderStatus NewStatus)
+{
+	{
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_Write);
+		if (PakPluginsByStatus[static_cast<int32>(OldStatus)].Remove(PakPlugin) == 0) // Only the PakPlugins registered with the subsystem are in the buckets
+		{
+			return;
+		}
+		PakPluginsByStatus[static_cast<int32>(NewStatus)].Add(PakPlugin);
+		
+		const bool bWasMounted = OldStatus >= EGFPakLoaderStatus::Mounted;
+		const bool bIsMounted = NewStatus >= EGFPakLoaderStatus::Mounted;
+		if (bWasMounted != bIsMounted)
+		{
+			if (bIsMounted)
+			{
+				MountedPakPluginsInOrder.Add(PakPlugin);
+				// The PakPlugin goes after the ones with the same priority, so the ones mounted first keep precedence
+				const int32 InsertIndex = MountedPakPluginsByPriority.IndexOfByPredicate([PakPlugin](const UGFPakPlugin* MountedPakPlugin) { return MountedPakPlugin->GetPakPriority() < PakPlugin->GetPakPriority(); });
+				MountedPakPluginsByPriority.Insert(PakPlugin, InsertIndex == INDEX_NONE ? MountedPakPluginsByPriority.Num() : InsertIndex);
+			}
+			else
+			{
+				MountedPakPluginsInOrder.Remove(PakPlugin);
+				MountedPakPluginsByPriority.Remove(PakPlugin);
+			}
+		}
+	}
+	
+	// The PluginName is known from `Unmounted`, and is already cleared when going back to `NotInitialized`
+	const bool bWasNamed = OldStatus >= EGFPakLoaderStatus::Unmounted;
+	const bool bIsNamed = NewStatus >= EGFPakLoaderStatus::Unmounted;
+	if (!bWasNamed && bIsNamed)
+	{
+		FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+		const FName PluginName(PakPlugin->GetPluginName());
+		if (!PakPluginsByName.Contains(PluginName)) // Only the first PakPlugin with a given name is able to mount
+		{
+			PakPluginsByName.Add(PluginName, PakPlugin);
+		}
+	}
+	else if (bWasNamed && !bIsNamed)
+	{
+		RemovePakPluginName(PakPlugin);
+	}
+}
+
+void UGFPakLoaderSubsystem::RemovePakPluginName(UGFPakPlugin* PakPlugin)
+{
+	// The PluginName of the PakPlugin might already be cleared, so we look for the PakPlugin itself
+	FName PluginName;
+	{
+		FRWScopeLock Lock(MountPointNamesLock, SLT_ReadOnly);
+		if (const FName* IndexedPluginName = PakPluginsByName.FindKey(PakPlugin))
+		{
+			PluginName = *IndexedPluginName;
+		}
+	}
+	if (PluginName.IsNone())
+	{
+		return;
+	}
+	
+	UGFPakPlugin* NextPakPlugin = nullptr;
+	EnumeratePakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Unmounted, [PakPlugin, PluginName, &NextPakPlugin](UGFPakPlugin* OtherPakPlugin)
+	{
+		if (OtherPakPlugin != PakPlugin && FName(OtherPakPlugin->GetPluginName()) == PluginName)
+		{
+			NextPakPlugin = OtherPakPlugin;
+			return EForEachResult::Break;
+		}
+		return EForEachResult::Continue;
+	});
+	
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	if (PakPluginsByName.FindRef(PluginName) == PakPlugin)
+	{
+		if (NextPakPlugin)
+		{
+			PakPluginsByName.Add(PluginName, NextPakPlugin);
+		}
+		else
+		{
+			PakPluginsByName.Remove(PluginName);
+		}
+	}
+}
+
+UGFPakPlugin* UGFPakLoaderSubsystem::FindPakPluginByDirectory(const FString& NormalizedPakPluginDirectory) const
+{
+	UGFPakPlugin* const* PakPlugin = GameFeaturesPakPluginsByDirectory.Find(NormalizedPakPluginDirectory);
+	// The directory of a Pak Plugin can be changed with UGFPakPlugin::SetPakPluginDirectory, in which case the entry is outdated
+	if (PakPlugin && IsValid(*PakPlugin) && (*PakPlugin)->GetPakPluginDirectory().Equals(NormalizedPakPluginDirectory, ESearchCase::IgnoreCase))
+	{
+		return *PakPlugin;
+	}
+	return nullptr;
+}
+
+FName UGFPakLoaderSubsystem::FindMountPointName(FStringView Path)
+{
+	const FStringView MountPointName = FPathViews::GetMountPointNameFromPath(Path);
+	return MountPointName.IsEmpty() ? NAME_None : FName(MountPointName.Len(), MountPointName.GetData(), FNAME_Find);
+}
+
+void UGFPakLoaderSubsystem::AddPakPluginMountPointNames(UGFPakPlugin* PakPlugin)
+{
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	for (const TSharedPtr<FPluginMountPoint>& MountPoint : PakPlugin->GetPakPluginMountPoints())
+	{
+		const FStringView MountPointName = FPathViews::GetMountPointNameFromPath(MountPoint->GetRootPath());
+		PakPluginsByMountPointName.Add(FName(MountPointName), {PakPlugin, MountPoint});
+	}
+}
+
+void UGFPakLoaderSubsystem::RemovePakPluginMountPointNames(UGFPakPlugin* PakPlugin)
+{
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	for (auto It = PakPluginsByMountPointName.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Key == PakPlugin)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UGFPakLoaderSubsystem::SetPakPluginMountPointAboutToBeMounted(UGFPakPlugin* PakPlugin, const FString& RootPath)
+{
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	if (const FName* PreviousMountPointName = PakPluginsByMountPointAboutToBeMounted.FindKey(PakPlugin))
+	{
+		PakPluginsByMountPointAboutToBeMounted.Remove(FName(*PreviousMountPointName));
+	}
+	if (!RootPath.IsEmpty())
+	{
+		PakPluginsByMountPointAboutToBeMounted.Add(FName(FPathViews::GetMountPointNameFromPath(RootPath)), PakPlugin);
+	}
+}
+#endif
+
+UGFPakPlugin* UGFPakLoaderSubsystem::FindPakPluginByMountPointName(FStringView MountPointName, const TCHAR** OutReason) const
+{
+	const FName Name = FindMountPointName(MountPointName);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+	
+	FRWScopeLock Lock(MountPointNamesLock, SLT_ReadOnly);
+#if WITH_EDITOR
+	// Some Content Browser callbacks are triggered before the MountPoints are added to the plugin
+	UGFPakPlugin* const* PakPluginAboutToMount = PakPluginsByMountPointAboutToBeMounted.Find(Name);
+	if (PakPluginAboutToMount && (*PakPluginAboutToMount)->GetStatus() == EGFPakLoaderStatus::Unmounted)
+	{
+		if (OutReason)
+		{
+			*OutReason = TEXT("MountPointAboutToBeMounted");
+		}
+		return *PakPluginAboutToMount;
+	}
+#endif
+	if (UGFPakPlugin* const* PakPlugin = PakPluginsByName.Find(Name))
+	{
+		if (OutReason)
+		{
+			*OutReason = TEXT("PLUGIN NAME");
+		}
+		return *PakPlugin;
+	}
+	for (auto It = PakPluginsByMountPointName.CreateConstKeyIterator(Name); It; ++It)
+	{
+		const TSharedPtr<FPluginMountPoint> MountPoint = It.Value().Value.Pin();
+		if (MountPoint && MountPoint->IsRegistered())
+		{
+			if (OutReason)
+			{
+				*OutReason = TEXT("REGISTERED MOUNT POINT");
+			}
+			return It.Value().Key;
+		}
+	}
+	return nullptr;
+}
+
+void UGFPakLoaderSubsystem::AddOnDemandPakPlugin(UGFPakPlugin* PakPlugin, const TArray<TSharedPtr<FPluginMountPoint>>& PakPluginMountPoints)
+{
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	OnDemandPakPluginsByMountPointName.FindOrAdd(FName(PakPlugin->GetPluginName()), PakPlugin);
+	for (const TSharedPtr<FPluginMountPoint>& MountPoint : PakPluginMountPoints)
+	{
+		// The Mount Points that existed before, like '/Game/', are shared with the Base Game and would mount the pak for any of their packages
+		if (MountPoint && MountPoint->NeedsUnregistering())
+		{
+			OnDemandPakPluginsByMountPointName.FindOrAdd(FName(FPathViews::GetMountPointNameFromPath(MountPoint->GetRootPath())), PakPlugin);
+		}
+	}
+}
+
+void UGFPakLoaderSubsystem::RemoveOnDemandPakPlugin(UGFPakPlugin* PakPlugin)
+{
+	FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+	for (auto It = OnDemandPakPluginsByMountPointName.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == PakPlugin)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UGFPakLoaderSubsystem::OnLoadPackage(const FString& PackageName)
+{
+	MountOnDemandPakPluginProvidingPackage(PackageName);
+}
+
+UGFPakPlugin* UGFPakLoaderSubsystem::MountOnDemandPakPluginProvidingPackage(FStringView PackageName)
+{
+	// The packages can be requested from any thread, but the mounting needs to happen on the Game Thread
+	if (!IsInGameThread())
+	{
+		return nullptr;
+	}
+	
+	UGFPakPlugin* PakPlugin = nullptr;
+	{
+		FRWScopeLock Lock(MountPointNamesLock, SLT_ReadOnly);
+		if (OnDemandPakPluginsByMountPointName.IsEmpty())
+		{
+			return nullptr;
+		}
+		if (UGFPakPlugin* const* OnDemandPakPlugin = OnDemandPakPluginsByMountPointName.Find(FindMountPointName(PackageName)))
+		{
+			PakPlugin = *OnDemandPakPlugin;
+		}
+	}
+	if (!IsValid(PakPlugin))
+	{
+		return nullptr;
+	}
+	
+	UE_LOG(LogGFPakLoader, Log, TEXT("Mounting the Pak Plugin '%s' registered on demand as its package '%.*s' is requested"), *PakPlugin->GetPluginName(), PackageName.Len(), PackageName.GetData())
+	return PakPlugin->Mount() ? PakPlugin : nullptr; // UGFPakPlugin::Mount removes the PakPlugin from OnDemandPakPluginsByMountPointName, so its own packages loaded while mounting do not mount it again
+}
+
 TSharedPtr<FPluginMountPoint> UGFPakLoaderSubsystem::AddOrCreateMountPointFromContentPath(const FString& InContentPath)
 {
 	if (!IsReady())
@@ -316,22 +734,27 @@ UGFPakPlugin* UGFPakLoaderSubsystem::FindMountedPakContainingFile(const TCHAR* O
 	const FString Extension {FPaths::GetExtension(OriginalFilename, true)};
 	
 	UGFPakPlugin* Plugin = nullptr;
-	EnumeratePakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Mounted, [&Plugin, &FilenameF, &PakAdjustedFilename](UGFPakPlugin* PakPlugin)
+	// If multiple Pak Plugins contain the same file, the one with the highest priority is used, and if equal, the first one mounted.
+	// As the Pak Plugins are sorted that way, the first one containing the file is the right one
 	{
-		if (const TSharedPtr<const FGFPakFilenameMap>* MountedFilenameFound = PakPlugin->GetPakFilenamesMap().Find(FilenameF))
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_ReadOnly);
+		for (UGFPakPlugin* PakPlugin : MountedPakPluginsByPriority)
 		{
-			if (const TSharedPtr<const FGFPakFilenameMap>& MountedFilename = *MountedFilenameFound)
+			if (!IsValid(PakPlugin))
+			{
+				continue;
+			}
+			if (const TSharedPtr<const FGFPakFilenameMap> MountedFilename = PakPlugin->FindPakFilename(FilenameF))
 			{
 				Plugin = PakPlugin;
 				if (PakAdjustedFilename)
 				{
 					*PakAdjustedFilename = MountedFilename->AdjustedFullFilename;
 				}
-				return EForEachResult::Break;
+				break;
 			}
 		}
-		return EForEachResult::Continue;
-	});
+	}
 	
 	if (!Plugin && PakAdjustedFilename)
 	{
@@ -423,10 +846,20 @@ void UGFPakLoaderSubsystem::Start()
 	// Instead, we override the IPluginManager::RegisterMountPointDelegate with our own where we stop the creation of a mount point for one of our Pak Plugin
 	// and we restore the regular delegate when the subsystem is destroyed.
 	IPluginManager::Get().SetRegisterMountPointDelegate(IPluginManager::FRegisterMountPointDelegate::CreateUObject(this, &UGFPakLoaderSubsystem::RegisterMountPoint));
+	
+	// The Pak Plugins registered on demand are mounted just before their first package is requested. See UGFPakLoaderSettings::bMountPakPluginsOnDemand
+	FCoreDelegates::OnSyncLoadPackage.AddUObject(this, &UGFPakLoaderSubsystem::OnLoadPackage);
+	FCoreDelegates::OnAsyncLoadPackage.AddUObject(this, &UGFPakLoaderSubsystem::OnLoadPackage);
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("...Initialized the UGFPakLoaderSubsystem"))
 	
 	OnSubsystemReadyDelegate.Broadcast();
 	
+	// The previous session is restored first, so its PakPlugins are mounted in their previous order before the startup folder mounts the other ones
+	if (GetPakLoaderSettings()->bRestorePreviousSession)
+	{
+		RestoreSessionSnapshot();
+	}
+	
 	if (GetPakLoaderSettings()->bAddPakPluginsFromStartupLoadDirectory)
 	{
 		const FString Path = GetDefaultPakPluginFolder();
@@ -446,137 +879,1528 @@ void UGFPakLoaderSubsystem::Start()
 	OnEnsureWorldIsLoadedInMemoryBeforeLoadingMapChanged();
 	
 	OnStartupPaksAddedDelegate.Broadcast();
+	
+	StartWatchingPakLoadPath();
+	
+	PakPluginsEvictionTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGFPakLoaderSubsystem::TickPakPluginsEviction), 1.f);
+	// The packages referenced by the loaded worlds are only gathered again when a world or a level changes
+	FWorldDelegates::OnPostWorldInitialization.AddWeakLambda(this, [this](UWorld*, const UWorld::InitializationValues) { bPackagesReferencedByLoadedWorldsDirty = true; });
+	FWorldDelegates::OnWorldCleanup.AddWeakLambda(this, [this](UWorld*, bool, bool) { bPackagesReferencedByLoadedWorldsDirty = true; });
+	FWorldDelegates::LevelAddedToWorld.AddWeakLambda(this, [this](ULevel*, UWorld*) { bPackagesReferencedByLoadedWorldsDirty = true; });
+	FWorldDelegates::LevelRemovedFromWorld.AddWeakLambda(this, [this](ULevel*, UWorld*) { bPackagesReferencedByLoadedWorldsDirty = true; });
+	// The eviction only looks again at the loaded packages of a PakPlugin after it was accessed or after a garbage collection
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddWeakLambda(this, [this]() { ++NumGarbageCollections; });
 }
 
-void UGFPakLoaderSubsystem::PakPluginStatusChanged(UGFPakPlugin* PakPlugin, EGFPakLoaderStatus OldValue, EGFPakLoaderStatus NewValue)
+void UGFPakLoaderSubsystem::OnWatchPakLoadPathChanged()
 {
-	OnPakPluginStatusChangedDelegate.Broadcast(PakPlugin, OldValue, NewValue);
+	StartWatchingPakLoadPath();
 }
 
-void UGFPakLoaderSubsystem::PakPluginDestroyed(UGFPakPlugin* PakPlugin)
+void UGFPakLoaderSubsystem::StartWatchingPakLoadPath()
 {
-	OnPakPluginRemovedDelegate.Broadcast(PakPlugin);
-	if (!bIsShuttingDown)
+	StopWatchingPakLoadPath();
+	if (!bStarted || !IsReady() || !GetPakLoaderSettings()->bWatchPakLoadPath)
 	{
-		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_Write);
-		GameFeaturesPakPlugins.Remove(PakPlugin);
+		return;
 	}
 	
-	if (PakPlugin)
+	FString PakLoadPath = FPaths::ConvertRelativePathToFull(GetDefaultPakPluginFolder());
+	FPaths::NormalizeDirectoryName(PakLoadPath);
+	if (!FPaths::DirectoryExists(PakLoadPath))
 	{
-		PakPlugin->OnStatusChanged().RemoveAll(this);
+		UE_LOG(LogGFPakLoader, Warning, TEXT("Unable to watch the Pak Plugin folder because the directory does not exist: '%s'"), *PakLoadPath)
+		return;
+	}
+	
+#if WITH_EDITOR
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+	if (!DirectoryWatcher || !DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(PakLoadPath, IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &ThisClass::OnWatchedDirectoryChanged),
+		DirectoryWatcherHandle, IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges))
+	{
+		UE_LOG(LogGFPakLoader, Error, TEXT("Unable to register a Directory Watcher for the Pak Plugin folder '%s'"), *PakLoadPath)
+		DirectoryWatcherHandle.Reset();
+		return;
+	}
+#else
+	FDirectoryLister DirectoryLister;
+	IFileManager::Get().IterateDirectory(*PakLoadPath, DirectoryLister);
+	for (FString& PluginPath : DirectoryLister.Directories)
+	{
+		FPaths::NormalizeDirectoryName(PluginPath);
+		if (!IsIgnoredPakPluginFolder(PluginPath))
+		{
+			WatchedPakPluginDirectories.Add(MoveTemp(PluginPath));
+		}
 	}
+	WatchedPakLoadPathTimestamp = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*PakLoadPath).ModificationTime;
+	LastPakLoadPathPollTime = FPlatformTime::Seconds();
+	LastPakPluginDirectoriesCheckTime = LastPakLoadPathPollTime;
+#endif
+	WatchedPakLoadPath = MoveTemp(PakLoadPath);
+	PakLoadPathWatcherTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TickPakLoadPathWatcher));
+	UE_LOG(LogGFPakLoader, Log, TEXT("Watching the Pak Plugin folder '%s' for added, changed and removed Pak Plugins"), *WatchedPakLoadPath)
 }
 
-void UGFPakLoaderSubsystem::RegisterMountPoint(const FString& RootPath, const FString& ContentPath)
+void UGFPakLoaderSubsystem::StopWatchingPakLoadPath()
 {
-	// To double-check the Mount Points being added, we could listen to the delegate FPackageName::OnContentPathMounted()
+	if (WatchedPakLoadPath.IsEmpty())
 	{
-		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_ReadOnly);
-		for (const UGFPakPlugin* GFPakPlugin : GameFeaturesPakPlugins)
+		return;
+	}
+	
+#if WITH_EDITOR
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
 		{
-			if (ensure(IsValid(GFPakPlugin)) && GFPakPlugin->GetStatus() > EGFPakLoaderStatus::Unmounted)
-			{
-				if (RootPath == GFPakPlugin->GetExpectedPluginMountPoint() && FPackageName::MountPointExists(RootPath))
+			DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedPakLoadPath, DirectoryWatcherHandle);
+		}
+	}
+	DirectoryWatcherHandle.Reset();
+#else
+	WatchedPakPluginDirectories.Empty();
+#endif
+	FTSTicker::GetCoreTicker().RemoveTicker(PakLoadPathWatcherTickHandle);
+	PakLoadPathWatcherTickHandle.Reset();
+	PendingPakPluginDirectories.Empty();
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("Stopped watching the Pak Plugin folder '%s'"), *WatchedPakLoadPath)
+	WatchedPakLoadPath.Empty();
+}
+
+#if WITH_EDITOR
+void UGFPakLoaderSubsystem::OnWatchedDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	for (const FFileChangeData& FileChange : FileChanges)
+	{
+		QueueWatchedPath(FileChange.Filename);
+	}
+}
+#else
+void UGFPakLoaderSubsystem::PollWatchedPakLoadPath()
+{
+	// Folders added or removed from the PakLoadPath. Only listed when the PakLoadPath itself changed
+	const FDateTime PakLoadPathTimestamp = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*WatchedPakLoadPath).ModificationTime;
+	if (PakLoadPathTimestamp != WatchedPakLoadPathTimestamp)
+	{
+		WatchedPakLoadPathTimestamp = PakLoadPathTimestamp;
+		
+		FDirectoryLister DirectoryLister;
+		IFileManager::Get().IterateDirectory(*WatchedPakLoadPath, DirectoryLister);
+		TSet<FString> PakPluginDirectories;
+		for (FString& PluginPath : DirectoryLister.Directories)
+		{
+			FPaths::NormalizeDirectoryName(PluginPath);
+			if (!IsIgnoredPakPluginFolder(PluginPath))
+			{
+				PakPluginDirectories.Add(MoveTemp(PluginPath));
+			}
+		}
+		for (const FString& PakPluginDirectory : PakPluginDirectories)
+		{
+			if (!WatchedPakPluginDirectories.Contains(PakPluginDirectory))
+			{
+				WatchedPakPluginDirectories.Add(PakPluginDirectory);
+				QueueWatchedPath(PakPluginDirectory);
+			}
+		}
+		for (auto It = WatchedPakPluginDirectories.CreateIterator(); It; ++It)
+		{
+			if (!PakPluginDirectories.Contains(It.Key()))
+			{
+				QueueWatchedPath(It.Key());
+				It.RemoveCurrent();
+			}
+		}
+	}
+	// The queued folders are polled by TickPakLoadPathWatcher while they are debounced
+}
+
+void UGFPakLoaderSubsystem::CheckWatchedPakPluginDirectories()
+{
+	// Known folders whose layout changed since they were last processed, which costs a few stat calls per folder, so this runs at its own, much longer, interval.
+	// The folders not processed yet by the watcher are compared with the FGFPakPluginDirectoryInfo cached when validating them, and queued once if there is none
+	for (const TPair<FString, TOptional<FGFPakPluginDirectoryInfo>>& WatchedDirectory : WatchedPakPluginDirectories)
+	{
+		if (PendingPakPluginDirectories.Contains(WatchedDirectory.Key))
+		{
+			continue;
+		}
+		TOptional<FGFPakPluginDirectoryInfo> DirectoryInfo = WatchedDirectory.Value;
+		if (!DirectoryInfo.IsSet())
+		{
+			FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+			if (const FGFPakPluginDirectoryInfo* CachedDirectoryInfo = PakPluginDirectoriesInfo.Find(WatchedDirectory.Key))
+			{
+				DirectoryInfo = *CachedDirectoryInfo;
+			}
+		}
+		if (!DirectoryInfo.IsSet() || !DirectoryInfo->IsUpToDate())
+		{
+			QueueWatchedPath(WatchedDirectory.Key);
+		}
+	}
+}
+#endif
+
+void UGFPakLoaderSubsystem::QueueWatchedPath(const FString& Path)
+{
+	FString FullPath = FPaths::ConvertRelativePathToFull(Path);
+	FPaths::NormalizeFilename(FullPath);
+	FStringView RelativePath;
+	if (WatchedPakLoadPath.IsEmpty() || !FPathViews::TryMakeChildPathRelativeTo(FullPath, WatchedPakLoadPath, RelativePath) || RelativePath.IsEmpty())
+	{
+		return;
+	}
+	
+	// The Pak Plugin folder is the first folder of the path relative to the PakLoadPath
+	int32 SeparatorIndex;
+	if (RelativePath.FindChar(TEXT('/'), SeparatorIndex))
+	{
+		RelativePath.LeftInline(SeparatorIndex);
+	}
+	const FString PakPluginDirectory = WatchedPakLoadPath / FString(RelativePath);
+	
+	const double Now = FPlatformTime::Seconds();
+	if (FPendingPakPluginDirectory* PendingDirectory = PendingPakPluginDirectories.Find(PakPluginDirectory))
+	{
+		PendingDirectory->LastChangeTime = Now;
+	}
+	else
+	{
+		FPendingPakPluginDirectory& NewPendingDirectory = PendingPakPluginDirectories.Add(PakPluginDirectory);
+		NewPendingDirectory.LastChangeTime = Now;
+		GetPakFilesStat(PakPluginDirectory, NewPendingDirectory.PakFilesSize, NewPendingDirectory.PakFilesTimestamp);
+		UE_LOG(LogGFPakLoader, VeryVerbose, TEXT("The Pak Plugin folder '%s' changed, queuing it for validation"), *PakPluginDirectory)
+	}
+}
+
+bool UGFPakLoaderSubsystem::TickPakLoadPathWatcher(float DeltaTime)
+{
+	if (!IsReady())
+	{
+		return true;
+	}
+	
+	const double Now = FPlatformTime::Seconds();
+	const double DebounceSeconds = GetPakLoaderSettings()->PakLoadPathWatchDebounceSeconds;
+#if !WITH_EDITOR
+	if (Now - LastPakLoadPathPollTime >= DebounceSeconds)
+	{
+		LastPakLoadPathPollTime = Now;
+		PollWatchedPakLoadPath();
+	}
+	if (Now - LastPakPluginDirectoriesCheckTime >= GetPakLoaderSettings()->PakLoadPathWatchFolderCheckSeconds)
+	{
+		LastPakPluginDirectoriesCheckTime = Now;
+		CheckWatchedPakPluginDirectories();
+	}
+#endif
+	
+	TArray<FString> ReadyPakPluginDirectories;
+	for (auto It = PendingPakPluginDirectories.CreateIterator(); It; ++It)
+	{
+		FPendingPakPluginDirectory& PendingDirectory = It.Value();
+		if (Now - PendingDirectory.LastChangeTime < DebounceSeconds)
+		{
+			continue;
+		}
+		
+		// The pak files might still be written without any new event, ex: when polling
+		int64 PakFilesSize;
+		FDateTime PakFilesTimestamp;
+		GetPakFilesStat(It.Key(), PakFilesSize, PakFilesTimestamp);
+		if (PakFilesSize != PendingDirectory.PakFilesSize || PakFilesTimestamp != PendingDirectory.PakFilesTimestamp)
+		{
+			PendingDirectory.PakFilesSize = PakFilesSize;
+			PendingDirectory.PakFilesTimestamp = PakFilesTimestamp;
+			PendingDirectory.LastChangeTime = Now;
+			continue;
+		}
+		ReadyPakPluginDirectories.Add(It.Key());
+		It.RemoveCurrent();
+	}
+	
+	// Processed outside of the iteration as adding or removing a Pak Plugin might end up queuing more changes
+	for (const FString& PakPluginDirectory : ReadyPakPluginDirectories)
+	{
+		ProcessWatchedPakPluginDirectory(PakPluginDirectory);
+	}
+	return true;
+}
+
+void UGFPakLoaderSubsystem::ProcessWatchedPakPluginDirectory(const FString& PakPluginDirectory)
+{
+	UGFPakPlugin* PakPlugin;
+	{
+		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_ReadOnly);
+		PakPlugin = FindPakPluginByDirectory(PakPluginDirectory);
+	}
+	
+	if (!FPaths::DirectoryExists(PakPluginDirectory))
+	{
+		{
+			FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+			PakPluginDirectoriesInfo.Remove(PakPluginDirectory);
+		}
+		if (PakPlugin)
+		{
+			UE_LOG(LogGFPakLoader, Log, TEXT("The Pak Plugin folder '%s' was removed, removing the Pak Plugin '%s'"), *PakPluginDirectory, *PakPlugin->GetPluginName())
+			PakPlugin->Deinitialize();
+			PakPlugin->ConditionalBeginDestroy();
+		}
+		return;
+	}
+	if (IsIgnoredPakPluginFolder(PakPluginDirectory))
+	{
+		return;
+	}
+	
+	if (!PakPlugin)
+	{
+		bool bIsNewlyAdded = false;
+		PakPlugin = GetOrAddPakPlugin(PakPluginDirectory, bIsNewlyAdded);
+		UE_CLOG(PakPlugin && bIsNewlyAdded, LogGFPakLoader, Log, TEXT("The Pak Plugin folder '%s' was added, added the Pak Plugin '%s'"), *PakPluginDirectory, *PakPlugin->GetPluginName())
+	}
+	else if (PakPlugin->GetStatus() <= EGFPakLoaderStatus::InvalidPluginDirectory)
+	{
+		UE_LOG(LogGFPakLoader, Log, TEXT("The Pak Plugin folder '%s' changed, loading the Pak Plugin data again"), *PakPluginDirectory)
+		PakPlugin->LoadPluginData();
+	}
+	else
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("The Pak Plugin folder '%s' changed, but the Pak Plugin '%s' is already loaded. The changes will be picked up the next time it is initialized"), *PakPluginDirectory, *PakPlugin->GetPluginName())
+	}
+	
+#if !WITH_EDITOR
+	// The layout of the folder is recorded as processed, so the polling only queues it again if it changes after this point
+	if (TOptional<FGFPakPluginDirectoryInfo>* WatchedDirectoryInfo = WatchedPakPluginDirectories.Find(PakPluginDirectory))
+	{
+		*WatchedDirectoryInfo = GetPakPluginDirectoryInfo(PakPluginDirectory);
+	}
+#endif
+}
+
+void UGFPakLoaderSubsystem::GetPakFilesStat(const FString& PakPluginDirectory, int64& OutSize, FDateTime& OutTimestamp)
+{
+	OutSize = 0;
+	OutTimestamp = FDateTime::MinValue();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	for (const FString& PakFile : GetPakPluginDirectoryInfo(PakPluginDirectory).PakFiles)
+	{
+		const FFileStatData PakFileStat = PlatformFile.GetStatData(*PakFile);
+		if (PakFileStat.bIsValid)
+		{
+			OutSize += PakFileStat.FileSize;
+			OutTimestamp = FMath::Max(OutTimestamp, PakFileStat.ModificationTime);
+		}
+	}
+}
+
+void UGFPakLoaderSubsystem::ScheduleGameFeatureActivation(UGFPakPlugin* PakPlugin, const FOperationCompleted& CompleteDelegate)
+{
+	if (!IsValid(PakPlugin) || bIsShuttingDown)
+	{
+		CompleteDelegate.ExecuteIfBound(false, {});
+		return;
+	}
+	
+	FScheduledGameFeatureActivation& ScheduledActivation = PendingGameFeatureActivations.AddDefaulted_GetRef();
+	ScheduledActivation.PakPlugin = PakPlugin;
+	ScheduledActivation.PluginName = FName(PakPlugin->GetPluginName());
+	ScheduledActivation.CompleteDelegate = CompleteDelegate;
+	for (const FPluginReferenceDescriptor& PluginReference : PakPlugin->GetPluginDescriptor().Plugins)
+	{
+		if (PluginReference.bEnabled && PluginReference.Name != PakPlugin->GetPluginName())
+		{
+			ScheduledActivation.Dependencies.Add(FName(PluginReference.Name));
+		}
+	}
+	bHasScheduledGameFeatureActivations = true;
+	RequestGameFeatureActivationsUpdate();
+}
+
+void UGFPakLoaderSubsystem::RequestGameFeatureActivationsUpdate()
+{
+	if (!GameFeatureActivationsTickHandle.IsValid() && !bIsShuttingDown)
+	{
+		GameFeatureActivationsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::UpdateScheduledGameFeatureActivations));
+	}
+}
+
+bool UGFPakLoaderSubsystem::UpdateScheduledGameFeatureActivations(float DeltaTime)
+{
+	GameFeatureActivationsTickHandle.Reset(); // We only tick once, returning false removes the ticker
+	
+	PendingGameFeatureActivations.RemoveAll([](const FScheduledGameFeatureActivation& ScheduledActivation)
+	{
+		if (!ScheduledActivation.PakPlugin.IsValid())
+		{
+			ScheduledActivation.CompleteDelegate.ExecuteIfBound(false, {});
+			return true;
+		}
+		return false;
+	});
+	
+	// A PakPlugin waits as long as one of its dependencies is still scheduled. The dependencies which are not scheduled are left to the UGameFeaturesSubsystem
+	TSet<FName> PendingPluginNames;
+	for (const FScheduledGameFeatureActivation& ScheduledActivation : PendingGameFeatureActivations)
+	{
+		PendingPluginNames.Add(ScheduledActivation.PluginName);
+	}
+	auto IsWaitingForDependencies = [this, &PendingPluginNames](const FScheduledGameFeatureActivation& ScheduledActivation)
+	{
+		return Algo::AnyOf(ScheduledActivation.Dependencies, [this, &PendingPluginNames](const FName Dependency)
+		{
+			return PendingPluginNames.Contains(Dependency) || InFlightGameFeatureActivations.Contains(Dependency);
+		});
+	};
+	
+	const int32 MaxConcurrentActivations = GetPakLoaderSettings()->MaxConcurrentGameFeatureActivations;
+	TArray<FScheduledGameFeatureActivation> ActivationsToStart;
+	for (int32 Index = 0; Index < PendingGameFeatureActivations.Num(); )
+	{
+		if (MaxConcurrentActivations > 0 && InFlightGameFeatureActivations.Num() + ActivationsToStart.Num() >= MaxConcurrentActivations)
+		{
+			break;
+		}
+		if (IsWaitingForDependencies(PendingGameFeatureActivations[Index]))
+		{
+			++Index;
+			continue;
+		}
+		ActivationsToStart.Add(MoveTemp(PendingGameFeatureActivations[Index]));
+		PendingGameFeatureActivations.RemoveAt(Index);
+	}
+	if (ActivationsToStart.IsEmpty() && InFlightGameFeatureActivations.IsEmpty() && !PendingGameFeatureActivations.IsEmpty())
+	{
+		// Nothing can progress, the remaining PakPlugins depend on each other
+		UE_LOG(LogGFPakLoader, Warning, TEXT("The scheduled GameFeature activations have a dependency cycle. Activating the Pak Plugin '%s' without waiting for its dependencies"),
+			*PendingGameFeatureActivations[0].PluginName.ToString())
+		ActivationsToStart.Add(MoveTemp(PendingGameFeatureActivations[0]));
+		PendingGameFeatureActivations.RemoveAt(0);
+	}
+	
+	for (FScheduledGameFeatureActivation& ScheduledActivation : ActivationsToStart)
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("Starting the scheduled GameFeature activation of the Pak Plugin '%s' (%d in flight, %d pending)"),
+			*ScheduledActivation.PluginName.ToString(), InFlightGameFeatureActivations.Num() + 1, PendingGameFeatureActivations.Num())
+		InFlightGameFeatureActivations.Add(ScheduledActivation.PluginName);
+		ScheduledActivation.PakPlugin->ActivateGameFeature(FOperationCompleted::CreateWeakLambda(this,
+			[this, PluginName = ScheduledActivation.PluginName, WeakPakPlugin = ScheduledActivation.PakPlugin, CompleteDelegate = MoveTemp(ScheduledActivation.CompleteDelegate)]
+			(const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>& Result)
+		{
+			InFlightGameFeatureActivations.RemoveSingle(PluginName);
+			if (!bSuccessful)
+			{
+				FailedGameFeatureActivations.Add(WeakPakPlugin);
+			}
+			CompleteDelegate.ExecuteIfBound(bSuccessful, Result);
+			RequestGameFeatureActivationsUpdate();
+		}));
+	}
+	
+	if (bHasScheduledGameFeatureActivations && PendingGameFeatureActivations.IsEmpty() && InFlightGameFeatureActivations.IsEmpty())
+	{
+		bHasScheduledGameFeatureActivations = false;
+		TArray<UGFPakPlugin*> FailedPakPlugins;
+		for (const TWeakObjectPtr<UGFPakPlugin>& FailedPakPlugin : FailedGameFeatureActivations)
+		{
+			if (FailedPakPlugin.IsValid())
+			{
+				FailedPakPlugins.Add(FailedPakPlugin.Get());
+			}
+		}
+		FailedGameFeatureActivations.Empty();
+		UE_LOG(LogGFPakLoader, Log, TEXT("All the scheduled GameFeature activations are completed, %d failed"), FailedPakPlugins.Num())
+		OnScheduledGameFeatureActivationsCompletedDelegate.Broadcast(FailedPakPlugins);
+	}
+	return false;
+}
+
+void UGFPakLoaderSubsystem::CancelScheduledGameFeatureActivations(UGFPakPlugin* PakPlugin)
+{
+	TArray<FOperationCompleted> CancelledDelegates;
+	PendingGameFeatureActivations.RemoveAll([PakPlugin, &CancelledDelegates](FScheduledGameFeatureActivation& ScheduledActivation)
+	{
+		if (ScheduledActivation.PakPlugin.Get() == PakPlugin)
+		{
+			CancelledDelegates.Add(MoveTemp(ScheduledActivation.CompleteDelegate));
+			return true;
+		}
+		return false;
+	});
+	if (CancelledDelegates.IsEmpty())
+	{
+		return;
+	}
+	
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("The Pak Plugin '%s' was unmounted before its scheduled GameFeature activation started, cancelling it"), *PakPlugin->GetPluginName())
+	FailedGameFeatureActivations.Add(PakPlugin);
+	// The delegates are called once the PakPlugin is removed from the queue, as they might schedule other activations
+	for (const FOperationCompleted& CancelledDelegate : CancelledDelegates)
+	{
+		CancelledDelegate.ExecuteIfBound(false, {});
+	}
+	// The other PakPlugins might have been waiting for this one
+	RequestGameFeatureActivationsUpdate();
+}
+
+void UGFPakLoaderSubsystem::ActivateGameFeatures(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate)
+{
+	RunBatchOperation(PakPlugins, CompleteDelegate, [this](UGFPakPlugin* PakPlugin, const FOperationCompleted& OperationCompleted)
+	{
+		ScheduleGameFeatureActivation(PakPlugin, OperationCompleted);
+	});
+}
+
+void UGFPakLoaderSubsystem::DeactivateGameFeatures(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate)
+{
+	RunBatchOperation(PakPlugins, CompleteDelegate, [](UGFPakPlugin* PakPlugin, const FOperationCompleted& OperationCompleted)
+	{
+		if (IsValid(PakPlugin))
+		{
+			PakPlugin->DeactivateGameFeature(OperationCompleted);
+		}
+		else
+		{
+			OperationCompleted.ExecuteIfBound(false, {});
+		}
+	});
+}
+
+void UGFPakLoaderSubsystem::RunBatchOperation(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate, TFunctionRef<void(UGFPakPlugin*, const FOperationCompleted&)> Operation)
+{
+	struct FBatchOperation
+	{
+		// The batch is not seen by the garbage collector, so the PakPlugins are only resolved when building the results
+		TArray<TWeakObjectPtr<UGFPakPlugin>> PakPlugins;
+		TArray<FGFPakPluginOperationResult> Results;
+		int32 NumRemaining = 0;
+		double StartTime = 0.0;
+		FBatchOperationCompleted CompleteDelegate;
+		
+		void CompleteOne()
+		{
+			if (--NumRemaining == 0)
+			{
+				for (int32 Index = 0; Index < Results.Num(); ++Index)
+				{
+					Results[Index].Plugin = PakPlugins[Index].Get();
+				}
+				CompleteDelegate.ExecuteIfBound(Results, FPlatformTime::Seconds() - StartTime);
+			}
+		}
+	};
+	
+	TArray<UGFPakPlugin*> UniquePakPlugins;
+	UniquePakPlugins.Reserve(PakPlugins.Num());
+	for (UGFPakPlugin* PakPlugin : PakPlugins)
+	{
+		UniquePakPlugins.AddUnique(PakPlugin);
+	}
+	
+	const TSharedRef<FBatchOperation> Batch = MakeShared<FBatchOperation>();
+	Batch->StartTime = FPlatformTime::Seconds();
+	Batch->CompleteDelegate = CompleteDelegate;
+	Batch->PakPlugins.Append(UniquePakPlugins);
+	Batch->Results.SetNum(UniquePakPlugins.Num());
+	Batch->NumRemaining = UniquePakPlugins.Num() + 1; // One more so the operations completing synchronously do not complete the batch before all of them are started
+	for (int32 Index = 0; Index < UniquePakPlugins.Num(); ++Index)
+	{
+		Operation(UniquePakPlugins[Index], FOperationCompleted::CreateLambda([Batch, Index](const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>& Result)
+		{
+			FGFPakPluginOperationResult& OperationResult = Batch->Results[Index];
+			OperationResult.bSuccessful = bSuccessful;
+			OperationResult.Error = Result.IsSet() && Result->HasError() ? Result->GetError() : FString();
+			OperationResult.CompletionSeconds = FPlatformTime::Seconds() - Batch->StartTime;
+			Batch->CompleteOne();
+		}));
+	}
+	Batch->CompleteOne();
+}
+
+void UGFPakLoaderSubsystem::ScheduleMount(UGFPakPlugin* PakPlugin, EGFPakMountPriority Priority, const FOperationCompleted& CompleteDelegate)
+{
+	if (!IsValid(PakPlugin) || bIsShuttingDown)
+	{
+		CompleteDelegate.ExecuteIfBound(false, {});
+		return;
+	}
+	
+	ScheduledMounts[static_cast<int32>(Priority)].Add({PakPlugin, CompleteDelegate});
+	if (!ScheduledMountsTickHandle.IsValid())
+	{
+		ScheduledMountsTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGFPakLoaderSubsystem::TickScheduledMounts));
+	}
+}
+
+FGFPakMountSchedulerStats UGFPakLoaderSubsystem::GetMountSchedulerStats() const
+{
+	FGFPakMountSchedulerStats Stats;
+	Stats.NumQueuedCriticalMounts = ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Critical)].Num();
+	Stats.NumQueuedNormalMounts = ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Normal)].Num();
+	Stats.NumQueuedBackgroundMounts = ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Background)].Num();
+	Stats.NumCompletedMounts = NumCompletedMounts;
+	Stats.MountedBytes = MountedBytes;
+	
+	const double WindowStartTime = FPlatformTime::Seconds() - MountThroughputWindowSeconds;
+	int32 NumRecentMounts = 0;
+	int64 RecentMountedBytes = 0;
+	for (const TPair<double, int64>& RecentMount : RecentMounts)
+	{
+		if (RecentMount.Key >= WindowStartTime)
+		{
+			++NumRecentMounts;
+			RecentMountedBytes += RecentMount.Value;
+		}
+	}
+	Stats.MountsPerSecond = static_cast<float>(NumRecentMounts / MountThroughputWindowSeconds);
+	Stats.MountedBytesPerSecond = static_cast<float>(RecentMountedBytes / MountThroughputWindowSeconds);
+	return Stats;
+}
+
+bool UGFPakLoaderSubsystem::TickScheduledMounts(float DeltaTime)
+{
+	if (!IsReady())
+	{
+		return true; // The mounts wait for the subsystem to be ready
+	}
+	const UGFPakLoaderSettings* Settings = GetPakLoaderSettings();
+	
+	// 1. All the Critical mounts are started right away
+	TArray<FScheduledMount> CriticalMounts = MoveTemp(ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Critical)]);
+	ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Critical)].Reset();
+	for (FScheduledMount& ScheduledMount : CriticalMounts)
+	{
+		RunScheduledMount(MoveTemp(ScheduledMount));
+	}
+	
+	// 2. Then the Normal mounts, spread over multiple frames
+	TArray<FScheduledMount>& NormalMounts = ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Normal)];
+	const int32 MaxNormalMounts = Settings->MaxScheduledMountsPerFrame > 0 ? Settings->MaxScheduledMountsPerFrame : MAX_int32;
+	for (int32 NumNormalMounts = 0; NumNormalMounts < MaxNormalMounts && !NormalMounts.IsEmpty(); ++NumNormalMounts)
+	{
+		FScheduledMount ScheduledMount = MoveTemp(NormalMounts[0]);
+		NormalMounts.RemoveAt(0);
+		RunScheduledMount(MoveTemp(ScheduledMount));
+	}
+	
+	// 3. And the Background mounts, from a token bucket refilled at the BackgroundMountBandwidth and holding at most a second of bandwidth
+	const double Now = FPlatformTime::Seconds();
+	const double Bandwidth = Settings->BackgroundMountBandwidth * 1024.0 * 1024.0;
+	BackgroundMountTokens = FMath::Min(BackgroundMountTokens + (Now - LastBackgroundMountTokensRefillTime) * Bandwidth, Bandwidth);
+	LastBackgroundMountTokensRefillTime = Now;
+	TArray<FScheduledMount>& BackgroundMounts = ScheduledMounts[static_cast<int32>(EGFPakMountPriority::Background)];
+	if (!BackgroundMounts.IsEmpty() && NormalMounts.IsEmpty() && !IsAsyncLoading() && (Bandwidth <= 0.0 || BackgroundMountTokens > 0.0))
+	{
+		FScheduledMount ScheduledMount = MoveTemp(BackgroundMounts[0]);
+		BackgroundMounts.RemoveAt(0);
+		// Only what the mount read is accounted for, the pak index and the AssetRegistry.bin, and not the whole pak whose files are only read when used.
+		// The bucket can go negative for a big index, in which case the next Background mounts wait for it to be paid back
+		const int64 MountReadBytes = RunScheduledMount(MoveTemp(ScheduledMount));
+		if (Bandwidth > 0.0)
+		{
+			BackgroundMountTokens -= MountReadBytes;
+		}
+	}
+	
+	const bool bHasScheduledMounts = Algo::AnyOf(ScheduledMounts, [](const TArray<FScheduledMount>& Mounts) { return !Mounts.IsEmpty(); });
+	if (!bHasScheduledMounts)
+	{
+		ScheduledMountsTickHandle.Reset();
+	}
+	return bHasScheduledMounts;
+}
+
+int64 UGFPakLoaderSubsystem::RunScheduledMount(FScheduledMount&& ScheduledMount)
+{
+	UGFPakPlugin* PakPlugin = ScheduledMount.PakPlugin.Get();
+	if (!IsValid(PakPlugin))
+	{
+		ScheduledMount.CompleteDelegate.ExecuteIfBound(false, {});
+		return 0;
+	}
+	
+	const bool bWasMounted = PakPlugin->GetStatus() >= EGFPakLoaderStatus::Mounted;
+	const bool bSuccessful = PakPlugin->Mount();
+	int64 MountReadBytes = 0;
+	if (bSuccessful && !bWasMounted)
+	{
+		MountReadBytes = PakPlugin->GetMountReadBytes();
+		const int64 PakFileSize = FMath::Max<int64>(FPlatformFileManager::Get().GetPlatformFile().FileSize(*PakPlugin->GetPakFilePath()), 0);
+		const double Now = FPlatformTime::Seconds();
+		RecentMounts.RemoveAll([WindowStartTime = Now - MountThroughputWindowSeconds](const TPair<double, int64>& RecentMount) { return RecentMount.Key < WindowStartTime; });
+		RecentMounts.Emplace(Now, PakFileSize);
+		++NumCompletedMounts;
+		MountedBytes += PakFileSize;
+	}
+	ScheduledMount.CompleteDelegate.ExecuteIfBound(bSuccessful, {});
+	return MountReadBytes;
+}
+
+FString UGFPakLoaderSubsystem::GetSessionSnapshotPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GFPakLoader/Session.json");
+}
+
+bool UGFPakLoaderSubsystem::SaveSessionSnapshot()
+{
+	TArray<TSharedPtr<FJsonValue>> PakPluginEntries;
+	{
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_ReadOnly);
+		for (const UGFPakPlugin* PakPlugin : MountedPakPluginsInOrder)
+		{
+			if (IsValid(PakPlugin))
+			{
+				const TSharedRef<FJsonObject> PakPluginEntry = MakeShared<FJsonObject>();
+				PakPluginEntry->SetStringField(TEXT("Directory"), PakPlugin->GetPakPluginDirectory());
+				PakPluginEntry->SetBoolField(TEXT("bGameFeatureActivated"), PakPlugin->GetStatus() == EGFPakLoaderStatus::ActivatingGameFeature || PakPlugin->GetStatus() == EGFPakLoaderStatus::GameFeatureActivated);
+				PakPluginEntries.Add(MakeShared<FJsonValueObject>(PakPluginEntry));
+			}
+		}
+	}
+	
+	const TSharedRef<FJsonObject> SnapshotJsonObject = MakeShared<FJsonObject>();
+	SnapshotJsonObject->SetArrayField(TEXT("PakPlugins"), PakPluginEntries);
+	const FString SnapshotPath = GetSessionSnapshotPath();
+	FString JsonText;
+	if (!FJsonSerializer::Serialize(SnapshotJsonObject, TJsonWriterFactory<>::Create(&JsonText)) || !FFileHelper::SaveStringToFile(JsonText, *SnapshotPath))
+	{
+		UE_LOG(LogGFPakLoader, Warning, TEXT("Unable to save the session snapshot to '%s'"), *SnapshotPath)
+		return false;
+	}
+	UE_LOG(LogGFPakLoader, Log, TEXT("Saved the %d mounted Pak Plugins of the session to '%s'"), PakPluginEntries.Num(), *SnapshotPath)
+	return true;
+}
+
+int32 UGFPakLoaderSubsystem::RestoreSessionSnapshot()
+{
+	if (!IsReady())
+	{
+		return 0;
+	}
+	
+	const FString SnapshotPath = GetSessionSnapshotPath();
+	FString JsonText;
+	TSharedPtr<FJsonObject> SnapshotJsonObject;
+	const TArray<TSharedPtr<FJsonValue>>* PakPluginEntries = nullptr;
+	if (!FFileHelper::LoadFileToString(JsonText, *SnapshotPath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), SnapshotJsonObject) ||
+		!SnapshotJsonObject.IsValid() || !SnapshotJsonObject->TryGetArrayField(TEXT("PakPlugins"), PakPluginEntries))
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("No session snapshot to restore from '%s'"), *SnapshotPath)
+		return 0;
+	}
+	
+	const double StartTime = FPlatformTime::Seconds();
+	UE_LOG(LogGFPakLoader, Log, TEXT("Restoring the %d Pak Plugins of the previous session from '%s'..."), PakPluginEntries->Num(), *SnapshotPath)
+	
+	// 1. The PakPlugins are mounted in the same order as in the previous session, as it decides which one provides an asset contained in multiple Pak Plugins of the same priority
+	int32 NumRestoredPakPlugins = 0;
+	TArray<UGFPakPlugin*> PakPluginsToActivate;
+	for (const TSharedPtr<FJsonValue>& PakPluginEntry : *PakPluginEntries)
+	{
+		const TSharedPtr<FJsonObject>* PakPluginEntryObject = nullptr;
+		FString Directory;
+		if (!PakPluginEntry.IsValid() || !PakPluginEntry->TryGetObject(PakPluginEntryObject) || !(*PakPluginEntryObject)->TryGetStringField(TEXT("Directory"), Directory))
+		{
+			continue;
+		}
+		if (!FPaths::DirectoryExists(Directory))
+		{
+			UE_LOG(LogGFPakLoader, Verbose, TEXT("  The Pak Plugin directory '%s' does not exist anymore"), *Directory)
+			continue;
+		}
+		
+		bool bIsNewlyAdded = false;
+		UGFPakPlugin* PakPlugin = GetOrAddPakPlugin(Directory, bIsNewlyAdded);
+		if (!PakPlugin || !PakPlugin->Mount())
+		{
+			UE_LOG(LogGFPakLoader, Warning, TEXT("  Unable to restore the Pak Plugin '%s'"), *Directory)
+			continue;
+		}
+		++NumRestoredPakPlugins;
+		
+		bool bGameFeatureActivated = false;
+		(*PakPluginEntryObject)->TryGetBoolField(TEXT("bGameFeatureActivated"), bGameFeatureActivated);
+		// The PakPlugins auto activated when mounted are already scheduled
+		const bool bIsScheduled = Algo::AnyOf(PendingGameFeatureActivations, [PakPlugin](const FScheduledGameFeatureActivation& ScheduledActivation) { return ScheduledActivation.PakPlugin == PakPlugin; });
+		if (bGameFeatureActivated && PakPlugin->GetStatus() == EGFPakLoaderStatus::Mounted && !bIsScheduled)
+		{
+			PakPluginsToActivate.Add(PakPlugin);
+		}
+	}
+	
+	// 2. Then their GameFeatures are activated together, the independent ones concurrently
+	if (!PakPluginsToActivate.IsEmpty())
+	{
+		ActivateGameFeatures(PakPluginsToActivate, FBatchOperationCompleted::CreateLambda([](const TArray<FGFPakPluginOperationResult>& Results, double TotalSeconds)
+		{
+			const int32 NumFailed = Algo::CountIf(Results, [](const FGFPakPluginOperationResult& Result) { return !Result.bSuccessful; });
+			UE_LOG(LogGFPakLoader, Log, TEXT("Restored the GameFeatures of %d Pak Plugins of the previous session in %.2fs, %d failed"), Results.Num() - NumFailed, TotalSeconds, NumFailed)
+		}));
+	}
+	
+	UE_LOG(LogGFPakLoader, Log, TEXT("...Restored %d Pak Plugins of the previous session in %.2fms, activating %d GameFeatures"),
+		NumRestoredPakPlugins, (FPlatformTime::Seconds() - StartTime) * 1000.0, PakPluginsToActivate.Num())
+	return NumRestoredPakPlugins;
+}
+
+bool UGFPakLoaderSubsystem::TickPakPluginsEviction(float DeltaTime)
+{
+	EvictLeastRecentlyUsedPakPlugins();
+	return true;
+}
+
+int32 UGFPakLoaderSubsystem::EvictLeastRecentlyUsedPakPlugins()
+{
+	const UGFPakLoaderSettings* Settings = GetPakLoaderSettings();
+	if (!IsReady() || (Settings->MaxMountedPakPlugins <= 0 && Settings->PakPluginsMemoryBudget <= 0))
+	{
+		return 0;
+	}
+	
+	int32 NumPakPluginsToEvict = 0;
+	if (Settings->MaxMountedPakPlugins > 0)
+	{
+		NumPakPluginsToEvict = GetNumPakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Mounted) - Settings->MaxMountedPakPlugins;
+	}
+	// The memory budget only applies to the content loaded from the paks, which is what unmounting them releases
+	const int64 MemoryBudget = static_cast<int64>(Settings->PakPluginsMemoryBudget) * 1024 * 1024;
+	if (NumPakPluginsToEvict <= 0 && MemoryBudget <= 0)
+	{
+		return 0;
+	}
+	
+	// 1. Only the PakPlugins in a stable Status are evicted, the other ones are in the middle of an operation which will change their Status
+	// They are copied, as evicting them changes their Status
+	TArray<UGFPakPlugin*> PakPlugins;
+	const double Now = FPlatformTime::Seconds();
+	EnumeratePakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Mounted, [&PakPlugins, Now, MinIdleSeconds = Settings->PakPluginEvictionMinIdleSeconds](UGFPakPlugin* PakPlugin)
+	{
+		const EGFPakLoaderStatus PakPluginStatus = PakPlugin->GetStatus();
+		if ((PakPluginStatus == EGFPakLoaderStatus::Mounted || PakPluginStatus == EGFPakLoaderStatus::GameFeatureActivated) && Now - PakPlugin->GetLastAccessTime() >= MinIdleSeconds)
+		{
+			PakPlugins.Add(PakPlugin);
+		}
+		return EForEachResult::Continue;
+	});
+	if (PakPlugins.IsEmpty())
+	{
+		return 0;
+	}
+	PakPlugins.Sort([](const UGFPakPlugin& A, const UGFPakPlugin& B) { return A.GetLastAccessTime() < B.GetLastAccessTime(); });
+	
+	// 2. The loaded packages sizes are only computed for these PakPlugins, and again once their loaded packages might have changed.
+	// The other mounted PakPlugins count with the last size computed for them, as they cannot be evicted right now anyway
+	int64 LoadedPackagesSize = 0;
+	if (MemoryBudget > 0)
+	{
+		for (const UGFPakPlugin* PakPlugin : PakPlugins)
+		{
+			FPakPluginEvictionState& EvictionState = GetPakPluginEvictionState(PakPlugin);
+			if (EvictionState.LoadedPackagesSize < 0)
+			{
+				EvictionState.LoadedPackagesSize = PakPlugin->GetLoadedPackagesSize();
+			}
+		}
+		EnumeratePakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Mounted, [this, &LoadedPackagesSize](const UGFPakPlugin* PakPlugin)
+		{
+			const FPakPluginEvictionState* EvictionState = PakPluginsEvictionStates.Find(PakPlugin);
+			LoadedPackagesSize += EvictionState ? FMath::Max<int64>(EvictionState->LoadedPackagesSize, 0) : 0;
+			return EForEachResult::Continue;
+		});
+	}
+	if (NumPakPluginsToEvict <= 0 && LoadedPackagesSize <= MemoryBudget)
+	{
+		return 0;
+	}
+	
+	// 3. Whether a PakPlugin is in use comes from its loaded packages, the cheap check of the loaded worlds first, then the referencers of its objects.
+	// The referencers of all the remaining PakPlugins are found together, and a PakPlugin found in use is not checked again until its loaded packages might have changed
+	const TSet<FName>& ReferencedPackages = GetPackagesReferencedByLoadedWorlds();
+	PakPlugins.RemoveAll([this, &ReferencedPackages](const UGFPakPlugin* PakPlugin)
+	{
+		if (GetPakPluginEvictionState(PakPlugin).IsContentInUse.Get(false))
+		{
+			return true;
+		}
+		if (Algo::AnyOf(ReferencedPackages, [PakPlugin](const FName PackageName) { return PakPlugin->ContainsPackage(PackageName); }))
+		{
+			UE_LOG(LogGFPakLoader, VeryVerbose, TEXT("Not evicting the Pak Plugin '%s' as its content is used by a loaded world"), *PakPlugin->GetPluginName())
+			return true;
+		}
+		return false;
+	});
+	TArray<const UGFPakPlugin*> PakPluginsToCheck;
+	for (const UGFPakPlugin* PakPlugin : PakPlugins)
+	{
+		if (!GetPakPluginEvictionState(PakPlugin).IsContentInUse.IsSet())
+		{
+			PakPluginsToCheck.Add(PakPlugin);
+		}
+	}
+	if (!PakPluginsToCheck.IsEmpty())
+	{
+		const TArray<bool> InUse = UGFPakPlugin::IsContentInUse(PakPluginsToCheck);
+		for (int32 Index = 0; Index < PakPluginsToCheck.Num(); ++Index)
+		{
+			GetPakPluginEvictionState(PakPluginsToCheck[Index]).IsContentInUse = InUse[Index];
+			UE_CLOG(InUse[Index], LogGFPakLoader, VeryVerbose, TEXT("Not evicting the Pak Plugin '%s' as its loaded content is still referenced"), *PakPluginsToCheck[Index]->GetPluginName())
+		}
+	}
+	
+	// 4. Then the least recently used ones are evicted until the budgets are met
+	int32 NumEvictedPakPlugins = 0;
+	for (UGFPakPlugin* PakPlugin : PakPlugins)
+	{
+		const bool bIsOverMountedBudget = NumEvictedPakPlugins < NumPakPluginsToEvict;
+		const bool bIsOverMemoryBudget = MemoryBudget > 0 && LoadedPackagesSize > MemoryBudget;
+		if (!bIsOverMountedBudget && !bIsOverMemoryBudget)
+		{
+			break;
+		}
+		const FPakPluginEvictionState& EvictionState = GetPakPluginEvictionState(PakPlugin);
+		if (EvictionState.IsContentInUse.Get(false))
+		{
+			continue;
+		}
+		const int64 PakPluginLoadedPackagesSize = FMath::Max<int64>(EvictionState.LoadedPackagesSize, 0);
+		if (!bIsOverMountedBudget && PakPluginLoadedPackagesSize <= 0)
+		{
+			continue; // Unmounting it would not release any memory
+		}
+		
+		UE_LOG(LogGFPakLoader, Log, TEXT("Evicting the Pak Plugin '%s', unused for %.1fs, as the %s budget is exceeded"), *PakPlugin->GetPluginName(),
+			Now - PakPlugin->GetLastAccessTime(), bIsOverMountedBudget ? TEXT("mounted Pak Plugins") : TEXT("memory"))
+		PakPluginsEvictionStates.Remove(PakPlugin);
+		EvictPakPlugin(PakPlugin);
+		++NumEvictedPakPlugins;
+		LoadedPackagesSize -= PakPluginLoadedPackagesSize;
+	}
+	return NumEvictedPakPlugins;
+}
+
+UGFPakLoaderSubsystem::FPakPluginEvictionState& UGFPakLoaderSubsystem::GetPakPluginEvictionState(const UGFPakPlugin* PakPlugin)
+{
+	FPakPluginEvictionState& EvictionState = PakPluginsEvictionStates.FindOrAdd(PakPlugin);
+	if (!EvictionState.IsUpToDate(PakPlugin, NumGarbageCollections))
+	{
+		EvictionState = {};
+		EvictionState.LastAccessTime = PakPlugin->GetLastAccessTime();
+		EvictionState.NumGarbageCollections = NumGarbageCollections;
+	}
+	return EvictionState;
+}
+
+void UGFPakLoaderSubsystem::EvictPakPlugin(UGFPakPlugin* PakPlugin)
+{
+	if (PakPlugin->GetStatus() == EGFPakLoaderStatus::GameFeatureActivated)
+	{
+		PakPlugin->DeactivateGameFeature(FOperationCompleted::CreateLambda([WeakPakPlugin = TWeakObjectPtr<UGFPakPlugin>(PakPlugin)](const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>&)
+		{
+			if (bSuccessful && WeakPakPlugin.IsValid() && WeakPakPlugin->GetStatus() == EGFPakLoaderStatus::Mounted)
+			{
+				EvictPakPlugin(WeakPakPlugin.Get());
+			}
+		}));
+		return;
+	}
+	
+	PakPlugin->Unmount();
+	if (GetPakLoaderSettings()->bMountPakPluginsOnDemand && PakPlugin->GetStatus() == EGFPakLoaderStatus::Unmounted)
+	{
+		PakPlugin->RegisterOnDemand();
+	}
+}
+
+const TSet<FName>& UGFPakLoaderSubsystem::GetPackagesReferencedByLoadedWorlds()
+{
+	if (!bPackagesReferencedByLoadedWorldsDirty)
+	{
+		return PackagesReferencedByLoadedWorlds;
+	}
+	bPackagesReferencedByLoadedWorldsDirty = false;
+	
+	TSet<FName>& ReferencedPackages = PackagesReferencedByLoadedWorlds;
+	ReferencedPackages.Reset();
+	if (!GEngine)
+	{
+		return ReferencedPackages;
+	}
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		const UWorld* World = WorldContext.World();
+		if (!World)
+		{
+			continue;
+		}
+		for (const ULevel* Level : World->GetLevels())
+		{
+			if (!Level)
+			{
+				continue;
+			}
+			ReferencedPackages.Add(Level->GetPackage()->GetFName());
+			for (const AActor* Actor : Level->Actors)
+			{
+				if (Actor)
+				{
+					ReferencedPackages.Add(Actor->GetClass()->GetPackage()->GetFName());
+				}
+			}
+		}
+	}
+	return ReferencedPackages;
+}
+
+void UGFPakLoaderSubsystem::PakPluginStatusChanged(UGFPakPlugin* PakPlugin, EGFPakLoaderStatus OldValue, EGFPakLoaderStatus NewValue)
+{
+	if (OldValue >= EGFPakLoaderStatus::Mounted && NewValue < EGFPakLoaderStatus::Mounted)
+	{
+		CancelScheduledGameFeatureActivations(PakPlugin);
+		PakPluginsEvictionStates.Remove(PakPlugin);
+	}
+	OnPakPluginStatusChangedDelegate.Broadcast(PakPlugin, OldValue, NewValue);
+}
+
+void UGFPakLoaderSubsystem::PakPluginDestroyed(UGFPakPlugin* PakPlugin)
+{
+	OnPakPluginRemovedDelegate.Broadcast(PakPlugin);
+	if (!bIsShuttingDown)
+	{
+		FRWScopeLock Lock(GameFeaturesPakPluginsLock, SLT_Write);
+		GameFeaturesPakPlugins.Remove(PakPlugin);
+		if (PakPlugin)
+		{
+			UGFPakPlugin** PakPluginByDirectory = GameFeaturesPakPluginsByDirectory.Find(PakPlugin->GetPakPluginDirectory());
+			if (PakPluginByDirectory && *PakPluginByDirectory == PakPlugin)
+			{
+				GameFeaturesPakPluginsByDirectory.Remove(PakPlugin->GetPakPluginDirectory());
+			}
+			else if (const FString* Directory = GameFeaturesPakPluginsByDirectory.FindKey(PakPlugin)) // The directory was changed with UGFPakPlugin::SetPakPluginDirectory
+			{
+				GameFeaturesPakPluginsByDirectory.Remove(FString(*Directory));
+			}
+		}
+	}
+	
+	if (PakPlugin)
+	{
+		{
+			FRWScopeLock Lock(PakPluginsByStatusLock, SLT_Write);
+			for (TArray<UGFPakPlugin*>& PakPlugins : PakPluginsByStatus)
+			{
+				PakPlugins.Remove(PakPlugin);
+			}
+			MountedPakPluginsInOrder.Remove(PakPlugin);
+			MountedPakPluginsByPriority.Remove(PakPlugin);
+		}
+		{
+			FScopeLock Lock(&PakPluginDirectoriesInfoMutex);
+			PakPluginDirectoriesInfo.Remove(PakPlugin->GetPakPluginDirectory());
+		}
+		RemovePluginFromAssetsIndex(PakPlugin);
+		RemovePakPluginMountPointNames(PakPlugin);
+		RemovePakPluginName(PakPlugin);
+		PakPluginsEvictionStates.Remove(PakPlugin);
+#if WITH_EDITOR
+		{
+			FRWScopeLock Lock(MountPointNamesLock, SLT_Write);
+			if (const FName* MountPointName = PakPluginsByMountPointAboutToBeMounted.FindKey(PakPlugin))
+			{
+				PakPluginsByMountPointAboutToBeMounted.Remove(FName(*MountPointName));
+			}
+		}
+#endif
+		PakPlugin->OnStatusChanged().RemoveAll(this);
+	}
+}
+
+void UGFPakLoaderSubsystem::RegisterMountPoint(const FString& RootPath, const FString& ContentPath)
+{
+	// To double-check the Mount Points being added, we could listen to the delegate FPackageName::OnContentPathMounted()
+	if (const FName PluginName = FindMountPointName(RootPath); !PluginName.IsNone())
+	{
+		FRWScopeLock Lock(MountPointNamesLock, SLT_ReadOnly);
+		UGFPakPlugin* const* GFPakPlugin = PakPluginsByName.Find(PluginName);
+		if (GFPakPlugin && ensure(IsValid(*GFPakPlugin)) && (*GFPakPlugin)->GetStatus() > EGFPakLoaderStatus::Unmounted)
+		{
+			if (RootPath == (*GFPakPlugin)->GetExpectedPluginMountPoint() && FPackageName::MountPointExists(RootPath))
+			{
+				UE_LOG(LogGFPakLoader, Warning, TEXT("UGFPakLoaderSubsystem stopped the IPluginManager from registering the PakPlugin MountPoint  '%s' => '%s'"), *RootPath, *ContentPath)
+				return;
+			}
+		}
+	}
+	
+	UE_LOG(LogGFPakLoader, Log, TEXT("UGFPakLoaderSubsystem::RegisterMountPoint: About to register MountPoint  '%s' => '%s'"), *RootPath, *ContentPath)
+	FPackageName::RegisterMountPoint(RootPath, ContentPath);
+}
+
+void UGFPakLoaderSubsystem::Debug_LogPaths()
+{
+	UE_LOG(LogGFPakLoader, Verbose, TEXT(" === UGFPakLoaderSubsystem: FPaths Functions IN '%s' ==="), GIsEditor ? TEXT("EDITOR") : TEXT("GAME") );
+	FString BaseDir = FPlatformProcess::BaseDir();
+	FString RootDir = FPlatformMisc::RootDir();
+	FString ProjectDir = FPlatformMisc::ProjectDir();
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  BaseDir         '%s' "), *BaseDir);
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  RootDir         '%s' "), *RootDir);
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  ProjectDir      '%s' "), *ProjectDir);
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Full ProjectDir '%s' "), *FPaths::ConvertRelativePathToFull(ProjectDir));
+		
+	TArray<FString> FilenamesToTest;
+	FilenamesToTest.Add(TEXT("/../../../Project/Plugins/GameFeatures/plugin-name/AssetRegistry.bin"));
+	FilenamesToTest.Add(TEXT("../../../Project/Plugins/GameFeatures/plugin-name/AssetRegistry.bin"));
+	FilenamesToTest.Add(TEXT("/../../../../"));
+	FilenamesToTest.Add(TEXT("../../../../"));
+	FilenamesToTest.Add(TEXT("/../../../"));
+	FilenamesToTest.Add(TEXT("../../../"));
+	FilenamesToTest.Add(TEXT("../../"));
+	FilenamesToTest.Add(TEXT("../"));
+	FilenamesToTest.Add(TEXT("./"));
+	FilenamesToTest.Add(TEXT("/"));
+
+	for (FString& FilenameTest : FilenamesToTest)
+	{
+		FString StandardFilenameTest = FilenameTest;
+		FPaths::MakeStandardFilename(StandardFilenameTest);
+			
+		FString Standardized = FPaths::ConvertRelativePathToFull(StandardFilenameTest);
+		// remove duplicate slashes
+		FPaths::RemoveDuplicateSlashes(Standardized);
+			
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("  - Test for Path ----------------    '%s'"), *FilenameTest);
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("      => MakeStandardFilename         '%s'"), *StandardFilenameTest);
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("      => ConvertRelativePathToFull    '%s'"), *Standardized);
+	}
+}
+
+void UGFPakLoaderSubsystem::OnContentPathMounted(const FString& AssetPath, const FString& ContentPath)
+{
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("OnContentPathMounted:     '%s'  =>  '%s'"), *AssetPath, *ContentPath);
+}
+
+void UGFPakLoaderSubsystem::OnContentPathDismounted(const FString& AssetPath, const FString& ContentPath)
+{
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("OnContentPathDismounted:  '%s'  =>  '%s'"), *AssetPath, *ContentPath);
+}
+
+void UGFPakLoaderSubsystem::OnEnsureWorldIsLoadedInMemoryBeforeLoadingMapChanged()
+{
+	if (GetPakLoaderSettings()->bEnsureWorldIsLoadedInMemoryBeforeLoadingMap)
+	{
+		if (!FCoreUObjectDelegates::PreLoadMapWithContext.IsBoundToObject(this))
+		{
+			FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &UGFPakLoaderSubsystem::PreLoadMapWithContext);
+		}
+	}
+	else
+	{
+		FCoreUObjectDelegates::PreLoadMapWithContext.RemoveAll(this);
+	}
+}
+
+void UGFPakLoaderSubsystem::OnPreAddPluginAssetRegistry(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin)
+{
+	IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
+	
+	// 1. We retrieve in one query the assets already registered in the packages of this plugin, instead of querying the Asset Registry for each plugin asset.
+	// Most of the plugin assets do not override anything, so only the real conflicts will be recorded in the AssetOverrides
+	FARFilter Filter;
+	{
+		TSet<FName> PluginPackageNames;
+		PluginPackageNames.Reserve(PluginAssetRegistry.GetNumPackages());
+		PluginAssetRegistry.EnumerateAllAssets([&PluginPackageNames](const FAssetData& AssetData)
+		{
+			PluginPackageNames.Add(AssetData.PackageName);
+		});
+		Filter.PackageNames = PluginPackageNames.Array();
+	}
+	if (Filter.PackageNames.IsEmpty())
+	{
+		return;
+	}
+	
+	TArray<FAssetData> ExistingAssets;
+	AssetRegistry.GetAssets(Filter, ExistingAssets, false);
+	ExistingAssets.RemoveAllSwap([&PluginAssetRegistry](const FAssetData& ExistingAsset)
+	{
+		return !PluginAssetRegistry.GetAssetByObjectPath(ExistingAsset.GetSoftObjectPath());
+	});
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Found %d assets of the Pak Plugin '%s' already registered in the Asset Registry"), ExistingAssets.Num(), *GetNameSafe(Plugin))
+	if (ExistingAssets.IsEmpty())
+	{
+		return;
+	}
+	
+	// 2. The existing assets are either Base Game assets or assets of other mounted Pak Plugins, so we check which Pak Plugins provide them, with their own Asset Data.
+	// This is done before locking the AssetOwnerMutex as the Pak Plugins lock is taken before it when unmounting
+	struct FExistingPluginOwner
+	{
+		UGFPakPlugin* Plugin = nullptr;
+		FAssetData AssetData;
+	};
+	TArray<FSoftObjectPath> ExistingAssetPaths;
+	ExistingAssetPaths.Reserve(ExistingAssets.Num());
+	for (const FAssetData& ExistingAsset : ExistingAssets)
+	{
+		ExistingAssetPaths.Add(ExistingAsset.GetSoftObjectPath());
+	}
+	TArray<TArray<FExistingPluginOwner, TInlineAllocator<1>>> ExistingAssetsPluginOwners;
+	ExistingAssetsPluginOwners.SetNum(ExistingAssets.Num());
+	EnumeratePakPluginsWithStatus<EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Mounted, [Plugin, &ExistingAssets, &ExistingAssetPaths, &ExistingAssetsPluginOwners](UGFPakPlugin* PakPlugin)
+	{
+		if (PakPlugin != Plugin)
+		{
+			for (int32 Index = 0; Index < ExistingAssetPaths.Num(); ++Index)
+			{
+				if (PakPlugin->ContainsAsset(ExistingAssetPaths[Index]))
+				{
+					FExistingPluginOwner& PluginOwner = ExistingAssetsPluginOwners[Index].AddDefaulted_GetRef();
+					PluginOwner.Plugin = PakPlugin;
+					if (!PakPlugin->GetPluginAssetData(ExistingAssetPaths[Index], PluginOwner.AssetData))
+					{
+						PluginOwner.AssetData = ExistingAssets[Index];
+					}
+				}
+			}
+		}
+		return EForEachResult::Continue;
+	});
+	
+	// 3. We can now record the conflicts. The ones that are already known only need the new owner
+	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
+	auto AddOwner = [this](const FSoftObjectPath& AssetPath, FAssetOverride& AssetOverride, UGFPakPlugin* OwnerPlugin, const FAssetData& AssetData)
+	{
+		if (AssetOverride.Owners.ContainsByPredicate([OwnerPlugin](const FAssetOverride::FOwner& Owner) { return Owner.Plugin == OwnerPlugin; }))
+		{
+			return;
+		}
+		if (OwnerPlugin)
+		{
+			AssetOverridesByPlugin.FindOrAdd(OwnerPlugin).Add(AssetPath);
+		}
+		FAssetOverride::FOwner NewOwner;
+		NewOwner.Plugin = OwnerPlugin;
+		NewOwner.Priority = OwnerPlugin ? OwnerPlugin->GetPakPriority() : MIN_int32;
+		NewOwner.AssetDataIndex = OverriddenAssetsData.Add(AssetData);
+		// The new owner goes after the existing owners with the same priority, so the ones mounted first keep precedence
+		const int32 InsertIndex = AssetOverride.Owners.IndexOfByPredicate([&NewOwner](const FAssetOverride::FOwner& Owner) { return Owner.Priority < NewOwner.Priority; });
+		AssetOverride.Owners.Insert(NewOwner, InsertIndex == INDEX_NONE ? AssetOverride.Owners.Num() : InsertIndex);
+	};
+	TSet<UGFPakPlugin*> PluginsWithChangedOverrides;
+	for (int32 Index = 0; Index < ExistingAssets.Num(); ++Index)
+	{
+		const FSoftObjectPath& AssetPath = ExistingAssetPaths[Index];
+		FAssetOverride* AssetOverride = AssetOverrides.Find(AssetPath);
+		if (!AssetOverride)
+		{
+			AssetOverride = &AssetOverrides.Add(AssetPath);
+			// The data currently in the Asset Registry are only the ones of the Base Game when no Pak Plugin provides the asset
+			if (ExistingAssetsPluginOwners[Index].IsEmpty())
+			{
+				AddOwner(AssetPath, *AssetOverride, nullptr, ExistingAssets[Index]);
+			}
+			for (const FExistingPluginOwner& PluginOwner : ExistingAssetsPluginOwners[Index])
+			{
+				AddOwner(AssetPath, *AssetOverride, PluginOwner.Plugin, PluginOwner.AssetData);
+			}
+		}
+		AddOwner(AssetPath, *AssetOverride, Plugin, *PluginAssetRegistry.GetAssetByObjectPath(AssetPath));
+		for (const FAssetOverride::FOwner& Owner : AssetOverride->Owners)
+		{
+			PluginsWithChangedOverrides.Add(Owner.Plugin);
+		}
+	}
+	
+	// 4. The class queries cached by the other owners might have been resolved before their assets were overridden, so they are resolved again
+	for (UGFPakPlugin* ChangedPlugin : PluginsWithChangedOverrides)
+	{
+		if (ChangedPlugin)
+		{
+			ChangedPlugin->ClassAssetsCache.Reset();
+		}
+	}
+}
+
+bool UGFPakLoaderSubsystem::FindOverriddenAssetData(const UGFPakPlugin* Plugin, const FSoftObjectPath& AssetPath, FAssetData& OutAssetData)
+{
+	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
+	if (const FAssetOverride* AssetOverride = AssetOverrides.Find(AssetPath))
+	{
+		if (const FAssetOverride::FOwner* Owner = AssetOverride->Owners.FindByPredicate([Plugin](const FAssetOverride::FOwner& AssetOwner) { return AssetOwner.Plugin == Plugin; }))
+		{
+			OutAssetData = OverriddenAssetsData[Owner->AssetDataIndex];
+			return true;
+		}
+	}
+	return false;
+}
+
+void UGFPakLoaderSubsystem::OnPostAddPluginAssetRegistry(UGFPakPlugin* Plugin)
+{
+	IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
+	
+	// Appending the Plugin Asset Registry replaced all the overridden assets, so we restore the ones that have a higher priority
+	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
+	const TSet<FSoftObjectPath>* PluginAssetOverrides = AssetOverridesByPlugin.Find(Plugin);
+	if (!PluginAssetOverrides)
+	{
+		return;
+	}
+	FAssetRegistryState WinningAssetsState{}; // Create a temporary AssetRegistryState as this is the only exposed way to update a state without the UObject
+	for (const FSoftObjectPath& AssetPath : *PluginAssetOverrides)
+	{
+		const FAssetOverride* AssetOverride = AssetOverrides.Find(AssetPath);
+		if (!ensure(AssetOverride))
+		{
+			continue;
+		}
+		const FAssetOverride::FOwner& WinningOwner = AssetOverride->Owners[0];
+		if (WinningOwner.Plugin != Plugin)
+		{
+			UE_LOG(LogGFPakLoader, Verbose, TEXT("  Keeping the asset '%s' from '%s' as it has a higher priority than the Pak Plugin '%s'"), *AssetPath.ToString(),
+				WinningOwner.Plugin ? *WinningOwner.Plugin->GetSafePluginName() : TEXT("the Base Game"), *GetNameSafe(Plugin))
+			WinningAssetsState.AddAssetData(new FAssetData(OverriddenAssetsData[WinningOwner.AssetDataIndex])); // needs to be a pointer to a new object! will be destroyed in the FAssetRegistryState destructor
+		}
+	}
+	if (WinningAssetsState.GetNumAssets() > 0)
+	{
+		AssetRegistry.AppendState(WinningAssetsState);
+	}
+}
+
+UGFPakPlugin* UGFPakLoaderSubsystem::GetWinningPakPlugin(const FSoftObjectPath& AssetPath, bool& bOutIsOverridden)
+{
+	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
+	const FAssetOverride* AssetOverride = AssetOverrides.Find(AssetPath);
+	bOutIsOverridden = AssetOverride != nullptr;
+	return AssetOverride ? AssetOverride->Owners[0].Plugin : nullptr;
+}
+
+void UGFPakLoaderSubsystem::EnumeratePakAssetsOfClass(const FTopLevelAssetPath& ClassPathName, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const
+{
+	FRWScopeLock Lock(PakAssetsIndexLock, SLT_ReadOnly);
+	if (const TArray<FGFPakPluginAsset>* PakAssets = PakAssetsIndex.AssetsByClass.Find(ClassPathName))
+	{
+		for (const FGFPakPluginAsset& PakAsset : *PakAssets)
+		{
+			if (Callback(PakAsset) == EForEachResult::Break)
+			{
+				return;
+			}
+		}
+	}
+}
+
+void UGFPakLoaderSubsystem::EnumeratePakAssetsInPath(FName PackagePath, bool bRecursive, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const
+{
+	FRWScopeLock Lock(PakAssetsIndexLock, SLT_ReadOnly);
+	TArray<FName, TInlineAllocator<16>> PathsToVisit{PackagePath};
+	while (!PathsToVisit.IsEmpty())
+	{
+		const FName Path = PathsToVisit.Pop();
+		if (const TArray<FGFPakPluginAsset>* PakAssets = PakAssetsIndex.AssetsByPackagePath.Find(Path))
+		{
+			for (const FGFPakPluginAsset& PakAsset : *PakAssets)
+			{
+				if (Callback(PakAsset) == EForEachResult::Break)
 				{
-					UE_LOG(LogGFPakLoader, Warning, TEXT("UGFPakLoaderSubsystem stopped the IPluginManager from registering the PakPlugin MountPoint  '%s' => '%s'"), *RootPath, *ContentPath)
 					return;
 				}
 			}
 		}
+		if (bRecursive)
+		{
+			if (const TSet<FName>* SubPaths = PakAssetsIndex.SubPackagePaths.Find(Path))
+			{
+				for (const FName& SubPath : *SubPaths)
+				{
+					PathsToVisit.Add(SubPath);
+				}
+			}
+		}
 	}
-	
-	UE_LOG(LogGFPakLoader, Log, TEXT("UGFPakLoaderSubsystem::RegisterMountPoint: About to register MountPoint  '%s' => '%s'"), *RootPath, *ContentPath)
-	FPackageName::RegisterMountPoint(RootPath, ContentPath);
 }
 
-void UGFPakLoaderSubsystem::Debug_LogPaths()
+void UGFPakLoaderSubsystem::EnumeratePakAssetsWithTagValue(FName Tag, const FString& Value, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const
 {
-	UE_LOG(LogGFPakLoader, Verbose, TEXT(" === UGFPakLoaderSubsystem: FPaths Functions IN '%s' ==="), GIsEditor ? TEXT("EDITOR") : TEXT("GAME") );
-	FString BaseDir = FPlatformProcess::BaseDir();
-	FString RootDir = FPlatformMisc::RootDir();
-	FString ProjectDir = FPlatformMisc::ProjectDir();
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("  BaseDir         '%s' "), *BaseDir);
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("  RootDir         '%s' "), *RootDir);
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("  ProjectDir      '%s' "), *ProjectDir);
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Full ProjectDir '%s' "), *FPaths::ConvertRelativePathToFull(ProjectDir));
-		
-	TArray<FString> FilenamesToTest;
-	FilenamesToTest.Add(TEXT("/../../../Project/Plugins/GameFeatures/plugin-name/AssetRegistry.bin"));
-	FilenamesToTest.Add(TEXT("../../../Project/Plugins/GameFeatures/plugin-name/AssetRegistry.bin"));
-	FilenamesToTest.Add(TEXT("/../../../../"));
-	FilenamesToTest.Add(TEXT("../../../../"));
-	FilenamesToTest.Add(TEXT("/../../../"));
-	FilenamesToTest.Add(TEXT("../../../"));
-	FilenamesToTest.Add(TEXT("../../"));
-	FilenamesToTest.Add(TEXT("../"));
-	FilenamesToTest.Add(TEXT("./"));
-	FilenamesToTest.Add(TEXT("/"));
+	FRWScopeLock Lock(PakAssetsIndexLock, SLT_ReadOnly);
+	const TMap<FString, TArray<FGFPakPluginAsset>>* AssetsByValue = PakAssetsIndex.AssetsByTagValue.Find(Tag);
+	if (const TArray<FGFPakPluginAsset>* PakAssets = AssetsByValue ? AssetsByValue->Find(Value) : nullptr)
+	{
+		for (const FGFPakPluginAsset& PakAsset : *PakAssets)
+		{
+			if (Callback(PakAsset) == EForEachResult::Break)
+			{
+				return;
+			}
+		}
+	}
+}
 
-	for (FString& FilenameTest : FilenamesToTest)
+void UGFPakLoaderSubsystem::GetPakAssetsOfClass(const UClass* Class, TArray<FGFPakPluginAsset>& OutPakAssets) const
+{
+	OutPakAssets.Reset();
+	if (Class)
 	{
-		FString StandardFilenameTest = FilenameTest;
-		FPaths::MakeStandardFilename(StandardFilenameTest);
-			
-		FString Standardized = FPaths::ConvertRelativePathToFull(StandardFilenameTest);
-		// remove duplicate slashes
-		FPaths::RemoveDuplicateSlashes(Standardized);
-			
-		UE_LOG(LogGFPakLoader, Verbose, TEXT("  - Test for Path ----------------    '%s'"), *FilenameTest);
-		UE_LOG(LogGFPakLoader, Verbose, TEXT("      => MakeStandardFilename         '%s'"), *StandardFilenameTest);
-		UE_LOG(LogGFPakLoader, Verbose, TEXT("      => ConvertRelativePathToFull    '%s'"), *Standardized);
+		EnumeratePakAssetsOfClass(Class->GetClassPathName(), [&OutPakAssets](const FGFPakPluginAsset& PakAsset)
+		{
+			OutPakAssets.Add(PakAsset);
+			return EForEachResult::Continue;
+		});
 	}
 }
 
-void UGFPakLoaderSubsystem::OnContentPathMounted(const FString& AssetPath, const FString& ContentPath)
+void UGFPakLoaderSubsystem::GetPakAssetsInPath(const FString& PackagePath, bool bRecursive, TArray<FGFPakPluginAsset>& OutPakAssets) const
 {
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("OnContentPathMounted:     '%s'  =>  '%s'"), *AssetPath, *ContentPath);
+	OutPakAssets.Reset();
+	FStringView Path = PackagePath;
+	if (Path.Len() > 1 && Path.EndsWith(TEXT('/')))
+	{
+		Path.LeftChopInline(1);
+	}
+	EnumeratePakAssetsInPath(FName(Path), bRecursive, [&OutPakAssets](const FGFPakPluginAsset& PakAsset)
+	{
+		OutPakAssets.Add(PakAsset);
+		return EForEachResult::Continue;
+	});
 }
 
-void UGFPakLoaderSubsystem::OnContentPathDismounted(const FString& AssetPath, const FString& ContentPath)
+void UGFPakLoaderSubsystem::GetPakAssetsWithTagValue(FName Tag, const FString& Value, TArray<FGFPakPluginAsset>& OutPakAssets) const
 {
-	UE_LOG(LogGFPakLoader, Verbose, TEXT("OnContentPathDismounted:  '%s'  =>  '%s'"), *AssetPath, *ContentPath);
+	OutPakAssets.Reset();
+	EnumeratePakAssetsWithTagValue(Tag, Value, [&OutPakAssets](const FGFPakPluginAsset& PakAsset)
+	{
+		OutPakAssets.Add(PakAsset);
+		return EForEachResult::Continue;
+	});
 }
 
-void UGFPakLoaderSubsystem::OnEnsureWorldIsLoadedInMemoryBeforeLoadingMapChanged()
+void UGFPakLoaderSubsystem::FPakAssetsIndex::AddPackagePath(FName PackagePath)
 {
-	if (GetPakLoaderSettings()->bEnsureWorldIsLoadedInMemoryBeforeLoadingMap)
+	// We register the path in its parent paths up to the root, stopping as soon as a parent already knew the path
+	FString Path = PackagePath.ToString();
+	int32 SlashIndex;
+	while (Path.FindLastChar(TEXT('/'), SlashIndex) && SlashIndex > 0)
 	{
-		if (!FCoreUObjectDelegates::PreLoadMapWithContext.IsBoundToObject(this))
+		bool bIsAlreadyInSet = false;
+		SubPackagePaths.FindOrAdd(FName(FStringView(Path).Left(SlashIndex))).Add(FName(*Path), &bIsAlreadyInSet);
+		if (bIsAlreadyInSet)
 		{
-			FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &UGFPakLoaderSubsystem::PreLoadMapWithContext);
+			break;
 		}
+		Path.LeftInline(SlashIndex);
 	}
-	else
+}
+
+void UGFPakLoaderSubsystem::FPakAssetsIndex::RemovePackagePathIfEmpty(FName PackagePath)
+{
+	// We remove the path from its parent paths as long as they do not have any asset or other sub path
+	FString Path = PackagePath.ToString();
+	int32 SlashIndex;
+	while (!AssetsByPackagePath.Contains(FName(*Path)) && !SubPackagePaths.Contains(FName(*Path)) && Path.FindLastChar(TEXT('/'), SlashIndex) && SlashIndex > 0)
 	{
-		FCoreUObjectDelegates::PreLoadMapWithContext.RemoveAll(this);
+		const FName ParentPath(FStringView(Path).Left(SlashIndex));
+		TSet<FName>* SiblingPaths = SubPackagePaths.Find(ParentPath);
+		if (!ensure(SiblingPaths))
+		{
+			break;
+		}
+		SiblingPaths->Remove(FName(*Path));
+		if (!SiblingPaths->IsEmpty())
+		{
+			break;
+		}
+		SubPackagePaths.Remove(ParentPath);
+		Path.LeftInline(SlashIndex);
 	}
 }
 
-void UGFPakLoaderSubsystem::OnPreAddPluginAssetRegistry(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin)
+void UGFPakLoaderSubsystem::AddPluginToAssetsIndex(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin)
 {
-	IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
+	const TArray<FName>& IndexedAssetTags = GetPakLoaderSettings()->IndexedAssetTags;
 	
-	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
-	PluginAssetRegistry.EnumerateAllAssets([this, &AssetRegistry, Plugin](const FAssetData& AssetData)
+	FRWScopeLock Lock(PakAssetsIndexLock, SLT_Write);
+	FPakAssetsIndex::FPluginKeys& PluginKeys = PakAssetsIndex.PluginKeys.FindOrAdd(Plugin);
+	PluginAssetRegistry.EnumerateAllAssets([this, Plugin, &IndexedAssetTags, &PluginKeys](const FAssetData& AssetData)
 	{
-		FSoftObjectPath AssetPath = AssetData.GetSoftObjectPath();
-		FAssetOwner* AssetOwner = AssetOwners.Find(AssetPath);
-		if (!AssetOwner)
+		const FGFPakPluginAsset PakAsset{Plugin, AssetData.GetSoftObjectPath()};
+		
+		PakAssetsIndex.AssetsByClass.FindOrAdd(AssetData.AssetClassPath).Add(PakAsset);
+		PluginKeys.Classes.Add(AssetData.AssetClassPath);
+		
+		PakAssetsIndex.AssetsByPackagePath.FindOrAdd(AssetData.PackagePath).Add(PakAsset);
+		bool bIsPathAlreadyIndexed = false;
+		PluginKeys.PackagePaths.Add(AssetData.PackagePath, &bIsPathAlreadyIndexed);
+		if (!bIsPathAlreadyIndexed)
 		{
-			AssetOwner = &AssetOwners.Add(AssetPath);
-			
-			const FAssetData GameAssetData = AssetRegistry.GetAssetByObjectPath(AssetPath, false, false);
-			if (GameAssetData.IsValid())
+			PakAssetsIndex.AddPackagePath(AssetData.PackagePath);
+		}
+		
+		for (const FName& Tag : IndexedAssetTags)
+		{
+			FString TagValue;
+			if (AssetData.GetTagValue(Tag, TagValue))
 			{
-				AssetOwner->bIsBaseGameAsset = true;
-				AssetOwner->BaseGameAssetData = GameAssetData;
+				PakAssetsIndex.AssetsByTagValue.FindOrAdd(Tag).FindOrAdd(TagValue).Add(PakAsset);
+				PluginKeys.TagValues.Emplace(Tag, MoveTemp(TagValue));
 			}
 		}
-		AssetOwner->PluginOwners.AddUnique(Plugin);
 	});
 }
 
+void UGFPakLoaderSubsystem::RemovePluginFromAssetsIndex(UGFPakPlugin* Plugin)
+{
+	FRWScopeLock Lock(PakAssetsIndexLock, SLT_Write);
+	FPakAssetsIndex::FPluginKeys PluginKeys;
+	if (!PakAssetsIndex.PluginKeys.RemoveAndCopyValue(Plugin, PluginKeys))
+	{
+		return;
+	}
+	
+	// Returns true if no other Pak Plugin has assets in the given list
+	auto RemovePluginAssets = [Plugin](TArray<FGFPakPluginAsset>* PakAssets)
+	{
+		if (ensure(PakAssets))
+		{
+			PakAssets->RemoveAll([Plugin](const FGFPakPluginAsset& PakAsset) { return PakAsset.Plugin == Plugin; });
+			return PakAssets->IsEmpty();
+		}
+		return false;
+	};
+	
+	for (const FTopLevelAssetPath& ClassPathName : PluginKeys.Classes)
+	{
+		if (RemovePluginAssets(PakAssetsIndex.AssetsByClass.Find(ClassPathName)))
+		{
+			PakAssetsIndex.AssetsByClass.Remove(ClassPathName);
+		}
+	}
+	for (const FName& PackagePath : PluginKeys.PackagePaths)
+	{
+		if (RemovePluginAssets(PakAssetsIndex.AssetsByPackagePath.Find(PackagePath)))
+		{
+			PakAssetsIndex.AssetsByPackagePath.Remove(PackagePath);
+			PakAssetsIndex.RemovePackagePathIfEmpty(PackagePath);
+		}
+	}
+	for (const TPair<FName, FString>& TagValue : PluginKeys.TagValues)
+	{
+		TMap<FString, TArray<FGFPakPluginAsset>>* AssetsByValue = PakAssetsIndex.AssetsByTagValue.Find(TagValue.Key);
+		if (AssetsByValue && RemovePluginAssets(AssetsByValue->Find(TagValue.Value)))
+		{
+			AssetsByValue->Remove(TagValue.Value);
+			if (AssetsByValue->IsEmpty())
+			{
+				PakAssetsIndex.AssetsByTagValue.Remove(TagValue.Key);
+			}
+		}
+	}
+}
+
 void UGFPakLoaderSubsystem::OnPreRemovePluginAssetRegistry(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin, TSet<FName>& OutPackageNamesToRemove)
 {
 	IAssetRegistry* AssetRegistryPtr = IAssetRegistry::Get();
@@ -586,29 +2410,48 @@ void UGFPakLoaderSubsystem::OnPreRemovePluginAssetRegistry(const FAssetRegistryS
 	}
 	
 	FScopeLock AssetOwnerLock(&AssetOwnerMutex);
-	TSet<FSoftObjectPath> AlreadyRemovedAssets;
-	PluginAssetRegistry.EnumerateAllAssets([this, Plugin, AssetRegistryPtr, &OutPackageNamesToRemove, &AlreadyRemovedAssets]
-		(const FAssetData& AssetData)
+	
+	// 1. We first decide which assets need to be removed, and group them by package so each package is only looked at once
+	TMap<FName, TArray<const FAssetData*, TInlineAllocator<2>>> AssetsToRemoveByPackage;
+	AssetsToRemoveByPackage.Reserve(PluginAssetRegistry.GetNumPackages());
+	FAssetRegistryState WinningAssetsState{}; // Create a temporary AssetRegistryState as this is the only exposed way to update a state without the UObject
+	TSet<UGFPakPlugin*> PluginsWithChangedOverrides;
+	PluginAssetRegistry.EnumerateAllAssets([this, Plugin, &AssetsToRemoveByPackage, &WinningAssetsState, &PluginsWithChangedOverrides](const FAssetData& AssetData)
 	{
 		FSoftObjectPath AssetPath = AssetData.GetSoftObjectPath();
 		bool bRemoveAsset = true;
-		if (FAssetOwner* AssetOwner = AssetOwners.Find(AssetPath)) // If new, check if the given asset is part of the Base Game Content
+		if (FAssetOverride* AssetOverride = AssetOverrides.Find(AssetPath)) // If overridden, the asset is kept and the next owner is restored if needed
 		{
 			bRemoveAsset = false;
-			if (AssetOwner->PluginOwners.Contains(Plugin))
+			TArray<FAssetOverride::FOwner, TInlineAllocator<2>>& Owners = AssetOverride->Owners;
+			const int32 OwnerIndex = Owners.IndexOfByPredicate([Plugin](const FAssetOverride::FOwner& Owner) { return Owner.Plugin == Plugin; });
+			if (OwnerIndex != INDEX_NONE)
 			{
-				AssetOwner->PluginOwners.Remove(Plugin);
-				if (AssetOwner->PluginOwners.IsEmpty())
+				OverriddenAssetsData.RemoveAt(Owners[OwnerIndex].AssetDataIndex);
+				Owners.RemoveAt(OwnerIndex);
+				for (const FAssetOverride::FOwner& Owner : Owners)
 				{
-					bRemoveAsset = !AssetOwner->bIsBaseGameAsset;
-					if (!bRemoveAsset)
+					PluginsWithChangedOverrides.Add(Owner.Plugin);
+				}
+				if (OwnerIndex == 0 && !Owners.IsEmpty())
+				{
+					WinningAssetsState.AddAssetData(new FAssetData(OverriddenAssetsData[Owners[0].AssetDataIndex])); // needs to be a pointer to a new object! will be destroyed in the FAssetRegistryState destructor 
+				}
+				if (Owners.Num() <= 1) // Not a conflict anymore
+				{
+					for (const FAssetOverride::FOwner& Owner : Owners)
 					{
-						FAssetRegistryState OldState{}; // Create a temporary AssetRegistryState as this is the only exposed way to update a state without the UObject
-						FAssetData* OldGameData = new FAssetData(AssetOwner->BaseGameAssetData);
-						OldState.AddAssetData(OldGameData); // needs to be a pointer to a new object! will be destroyed in the FAssetRegistryState destructor 
-						AssetRegistryPtr->AppendState(OldState);
+						OverriddenAssetsData.RemoveAt(Owner.AssetDataIndex);
+						if (TSet<FSoftObjectPath>* OwnerAssetOverrides = Owner.Plugin ? AssetOverridesByPlugin.Find(Owner.Plugin) : nullptr)
+						{
+							OwnerAssetOverrides->Remove(AssetPath);
+							if (OwnerAssetOverrides->IsEmpty())
+							{
+								AssetOverridesByPlugin.Remove(Owner.Plugin);
+							}
+						}
 					}
-					AssetOwners.Remove(AssetPath);
+					AssetOverrides.Remove(AssetPath);
 				}
 			}
 		}
@@ -617,69 +2460,104 @@ void UGFPakLoaderSubsystem::OnPreRemovePluginAssetRegistry(const FAssetRegistryS
 			UE_LOG(LogGFPakLoader, Display, TEXT("Not removing asset '%s' from Asset Registry. Flags: [ %s ]"), *AssetPath.ToString(), *PackageFlagsToString(AssetData.PackageFlags))
 			return;
 		}
-		AlreadyRemovedAssets.Add(AssetPath);
+		AssetsToRemoveByPackage.FindOrAdd(AssetData.PackageName).Add(&AssetData);
+	});
+	AssetOverridesByPlugin.Remove(Plugin); // All the overrides of the plugin were just gone through
+	for (UGFPakPlugin* ChangedPlugin : PluginsWithChangedOverrides)
+	{
+		if (ChangedPlugin)
+		{
+			ChangedPlugin->ClassAssetsCache.Reset();
+		}
+	}
+	
+	if (WinningAssetsState.GetNumAssets() > 0)
+	{
+		AssetRegistryPtr->AppendState(WinningAssetsState);
+	}
+	
+	// 2. Then we remove the assets package by package, and let the listeners know about all the removed assets at once
+	TArray<FAssetData> RemovedAssets;
+	TArray<UPackage*> DeletedPackages;
+	TArray<FAssetData> ExistingPackageAssets;
+	for (const TPair<FName, TArray<const FAssetData*, TInlineAllocator<2>>>& PackageAssets : AssetsToRemoveByPackage)
+	{
+		const FName PackageName = PackageAssets.Key;
 		
-		TArray<FAssetData> ExistingPackageAssets;
-		AssetRegistryPtr->GetAssetsByPackageName(AssetData.PackageName, ExistingPackageAssets, false, false /* See below */);
+		ExistingPackageAssets.Reset();
+		AssetRegistryPtr->GetAssetsByPackageName(PackageName, ExistingPackageAssets, false, false /* See below */);
 		// Note: in Cooked Packages, Blueprints have 2 assets within the same package: the Blueprint itself and the BlueprintGeneratedClass '_C'.
 		// UE does not support having both in some functions like AssetRegistry.GetAssetsByPackageName, so the default filtering (for cooked packages) will
 		// filter out the BP and keep the class as per UE::AssetRegistry::Utils::ShouldSkipAsset
-		bool bRemovePackage = (ExistingPackageAssets.Num() <= 1); // If there is only one asset (the current one), we can remove the package
-		if (!bRemovePackage)
+		// The package can only be removed if all the assets it currently holds are being removed
+		const bool bRemovePackage = ExistingPackageAssets.Num() <= 1 || Algo::AllOf(ExistingPackageAssets, [&PackageAssets](const FAssetData& ExistingAsset)
 		{
-			ExistingPackageAssets.Remove(AssetData);
-			for (auto It = ExistingPackageAssets.CreateIterator(); It; ++It)
+			return Algo::AnyOf(PackageAssets.Value, [&ExistingAsset](const FAssetData* AssetData)
 			{
-				FSoftObjectPath ExistingAssetPath = It->GetSoftObjectPath();
-				if (AlreadyRemovedAssets.Contains(ExistingAssetPath))
-				{
-					It.RemoveCurrent();
-				}
-			}
-			bRemovePackage = ExistingPackageAssets.IsEmpty();
-		}
-		
+				return AssetData->AssetName == ExistingAsset.AssetName;
+			});
+		});
 		
-		UE_CLOG(AssetData.AssetClassPath == UWorld::StaticClass()->GetClassPathName(), LogGFPakLoader, Verbose, TEXT("Removing MAP Asset from Asset Registry: '%s'"), *AssetData.GetObjectPathString())
-		UE_CLOG(AssetData.AssetClassPath != UWorld::StaticClass()->GetClassPathName(), LogGFPakLoader, VeryVerbose, TEXT("   Removing Asset from Asset Registry: '%s'"), *AssetData.GetObjectPathString())
+		UPackage* DeletedObjectPackage = PackageName.IsNone() || !bRemovePackage ? nullptr : FindPackage(nullptr, *PackageName.ToString()); // do not force load the package
 		
-		UPackage* DeletedObjectPackage = AssetData.PackageName.IsNone() || !bRemovePackage ? nullptr : FindPackage(nullptr, *AssetData.PackageName.ToString()); // do not force load the package
-		UObject* AssetToDelete = AssetData.FastGetAsset();
-
-		// The below is the Runtime and Editor equivalent of ObjectTools::DeleteSingleObject(AssetToDelete, false) which is editor only
-		if (AssetToDelete)
+		for (const FAssetData* AssetData : PackageAssets.Value)
 		{
-#if WITH_EDITOR
-			if (GEditor)
+			UE_CLOG(AssetData->AssetClassPath == UWorld::StaticClass()->GetClassPathName(), LogGFPakLoader, Verbose, TEXT("Removing MAP Asset from Asset Registry: '%s'"), *AssetData->GetObjectPathString())
+			UE_CLOG(AssetData->AssetClassPath != UWorld::StaticClass()->GetClassPathName(), LogGFPakLoader, VeryVerbose, TEXT("   Removing Asset from Asset Registry: '%s'"), *AssetData->GetObjectPathString())
+			
+			UObject* AssetToDelete = AssetData->FastGetAsset();
+			
+			// The below is the Runtime and Editor equivalent of ObjectTools::DeleteSingleObject(AssetToDelete, false) which is editor only
+			if (AssetToDelete)
 			{
-				if (GEditor->GetSelectedObjects())
-				{
-					GEditor->GetSelectedObjects()->Deselect(AssetToDelete);
-				}
-				if (AssetToDelete->IsAsset())
+#if WITH_EDITOR
+				if (GEditor)
 				{
-					if (UAssetEditorSubsystem* AssetEditor = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					if (GEditor->GetSelectedObjects())
+					{
+						GEditor->GetSelectedObjects()->Deselect(AssetToDelete);
+					}
+					if (AssetToDelete->IsAsset())
 					{
-						AssetEditor->CloseAllEditorsForAsset(AssetToDelete);
+						if (UAssetEditorSubsystem* AssetEditor = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+						{
+							AssetEditor->CloseAllEditorsForAsset(AssetToDelete);
+						}
 					}
 				}
-			}
 #endif
-
-			ForEachObjectWithOuter(AssetToDelete, [](UObject* Object)
-			{
-				Object->RemoveFromRoot();
-				Object->ClearFlags(RF_Standalone);
-			}, true);
-			if (UWorld* World = Cast<UWorld>(AssetToDelete))
+				
+				ForEachObjectWithOuter(AssetToDelete, [](UObject* Object)
+				{
+					Object->RemoveFromRoot();
+					Object->ClearFlags(RF_Standalone);
+				}, true);
+				if (UWorld* World = Cast<UWorld>(AssetToDelete))
+				{
+					World->CleanupWorld();
+				}
+				
+				AssetToDelete->MarkPackageDirty();
+				
+				// Equivalent of FAssetRegistryModule::AssetDeleted( AssetToDelete ) which is Editor only
+				// We might need to find a way to add the package to the EmptyPackageCache as per FAssetRegistryModule::AssetDeleted, but it works without
+				RemovedAssets.Emplace(AssetToDelete, FAssetData::ECreationFlags::AllowBlueprintClass, EAssetRegistryTagsCaller::AssetRegistryQuery);
+				
+				// Notify listeners that an in-memory asset was just deleted
+				AssetRegistryPtr->OnInMemoryAssetDeleted().Broadcast(AssetToDelete);
+				
+				// Remove standalone flag so garbage collection can delete the object and public flag so that the object is no longer considered to be an asset
+				AssetToDelete->ClearFlags(RF_Standalone | RF_Public);
+			}
+			else
 			{
-				World->CleanupWorld();
+				RemovedAssets.Add(*AssetData);
 			}
 		}
 		
 		if (bRemovePackage)
 		{
-			OutPackageNamesToRemove.Add(AssetData.PackageName);
+			OutPackageNamesToRemove.Add(PackageName);
 			if (DeletedObjectPackage)
 			{
 				ForEachObjectWithOuter(DeletedObjectPackage, [](UObject* Object)
@@ -687,42 +2565,28 @@ void UGFPakLoaderSubsystem::OnPreRemovePluginAssetRegistry(const FAssetRegistryS
 					Object->RemoveFromRoot();
 					Object->ClearFlags(RF_Standalone);
 				}, true);
+				DeletedPackages.Add(DeletedObjectPackage);
 			}
 		}
-		
-		if (AssetToDelete)
-		{
-			AssetToDelete->MarkPackageDirty();
-
-			// Equivalent of FAssetRegistryModule::AssetDeleted( AssetToDelete ) which is Editor only
-			{
-				// We might need to find a way to add the package to the EmptyPackageCache as per FAssetRegistryModule::AssetDeleted, but it works without
-				FAssetData AssetDataDeleted = FAssetData(AssetToDelete, FAssetData::ECreationFlags::AllowBlueprintClass,
-					EAssetRegistryTagsCaller::AssetRegistryQuery);
-				// Let subscribers know that the asset was removed from the registry
-				AssetRegistryPtr->OnAssetRemoved().Broadcast(AssetDataDeleted);
-				AssetRegistryPtr->OnAssetsRemoved().Broadcast({AssetDataDeleted});
-
-				// Notify listeners that an in-memory asset was just deleted
-				AssetRegistryPtr->OnInMemoryAssetDeleted().Broadcast(AssetToDelete);
-			}
-			// Remove standalone flag so garbage collection can delete the object and public flag so that the object is no longer considered to be an asset
-			AssetToDelete->ClearFlags(RF_Standalone | RF_Public);
-		}
-		else
-		{
-			AssetRegistryPtr->OnAssetRemoved().Broadcast(AssetData);
-			AssetRegistryPtr->OnAssetsRemoved().Broadcast({AssetData});
-		}
-
+	}
+	
+	// Let subscribers know that the assets were removed from the registry. As per UAssetRegistryImpl, OnAssetRemoved is called for each asset, but OnAssetsRemoved only once
+	for (const FAssetData& RemovedAsset : RemovedAssets)
+	{
+		AssetRegistryPtr->OnAssetRemoved().Broadcast(RemovedAsset);
+	}
+	if (!RemovedAssets.IsEmpty())
+	{
+		AssetRegistryPtr->OnAssetsRemoved().Broadcast(RemovedAssets);
+	}
+	
 #if WITH_EDITOR
-		if (bRemovePackage && DeletedObjectPackage)
-		{
-			AssetRegistryPtr->PackageDeleted(DeletedObjectPackage);
-		}
+	for (UPackage* DeletedPackage : DeletedPackages)
+	{
+		AssetRegistryPtr->PackageDeleted(DeletedPackage);
+	}
 #endif
-	});
-	
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("Removed %d Assets in %d Packages from the Asset Registry for the Pak Plugin '%s'"), RemovedAssets.Num(), AssetsToRemoveByPackage.Num(), *GetNameSafe(Plugin))
 }
 
 FString UGFPakLoaderSubsystem::PackageFlagsToString(uint32 PackageFlags)
@@ -18,10 +18,13 @@
 #include "Algo/Find.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/AssetRegistryState.h"
+#include "Async/Async.h"
 #include "Engine/AssetManager.h"
 #include "Engine/Level.h"
+#include "Engine/StreamableManager.h"
 #include "GameFramework/WorldSettings.h"
 #include "HAL/FileManagerGeneric.h"
+#include "HAL/PlatformFileManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/FeedbackContext.h"
@@ -30,6 +33,7 @@
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "UObject/LinkerLoad.h"
+#include "UObject/ReferencerFinder.h"
 
 #if WITH_EDITOR
 #include "ComponentRecreateRenderStateContext.h"
@@ -106,6 +110,81 @@ FGFPakFilenameMap FGFPakFilenameMap::FromFilenameAndMountPoints(const FString& O
 	return PakFilename;
 }
 
+FGFPakPluginDirectoryInfo FGFPakPluginDirectoryInfo::FromDirectory(const FString& PakPluginDirectory)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FGFPakPluginDirectoryInfo DirectoryInfo;
+	
+	// 1. The plugin directory itself, which needs to contain the .uplugin
+	const FFileStatData DirectoryStat = PlatformFile.GetStatData(*PakPluginDirectory);
+	DirectoryInfo.bDirectoryExists = DirectoryStat.bIsValid && DirectoryStat.bIsDirectory;
+	DirectoryInfo.DirectoryTimestamps.Emplace(PakPluginDirectory, DirectoryInfo.bDirectoryExists ? DirectoryStat.ModificationTime : FDateTime::MinValue());
+	if (!DirectoryInfo.bDirectoryExists)
+	{
+		return DirectoryInfo;
+	}
+	
+	const FString UPluginFilename = FPaths::GetBaseFilename(PakPluginDirectory) + TEXT(".uplugin");
+	FDirectoryStatLister PluginDirectoryLister;
+	PlatformFile.IterateDirectoryStat(*PakPluginDirectory, PluginDirectoryLister);
+	DirectoryInfo.bHasUPlugin = PluginDirectoryLister.Files.ContainsByPredicate([&UPluginFilename](const FString& Filename)
+	{
+		return FPaths::GetCleanFilename(Filename) == UPluginFilename;
+	});
+	
+	// 2. The Paks directory and its platform directories, which need to contain the pak
+	const FString PaksDirectory = PakPluginDirectory / UGFPakPlugin::PaksFolderFromDirectory;
+	const FFileStatData PaksDirectoryStat = PlatformFile.GetStatData(*PaksDirectory);
+	DirectoryInfo.bHasPaksDirectory = PaksDirectoryStat.bIsValid && PaksDirectoryStat.bIsDirectory;
+	DirectoryInfo.DirectoryTimestamps.Emplace(PaksDirectory, DirectoryInfo.bHasPaksDirectory ? PaksDirectoryStat.ModificationTime : FDateTime::MinValue());
+	if (!DirectoryInfo.bHasPaksDirectory)
+	{
+		return DirectoryInfo;
+	}
+	
+	auto AddPakFiles = [&DirectoryInfo](const TArray<FString>& Filenames)
+	{
+		for (const FString& Filename : Filenames)
+		{
+			if (Filename.EndsWith(TEXT(".pak")))
+			{
+				DirectoryInfo.PakFiles.Add(Filename);
+			}
+			else if (Filename.EndsWith(TEXT(".utoc")))
+			{
+				DirectoryInfo.UtocFiles.Add(Filename);
+			}
+		}
+	};
+	
+	FDirectoryStatLister PaksDirectoryLister;
+	PlatformFile.IterateDirectoryStat(*PaksDirectory, PaksDirectoryLister);
+	AddPakFiles(PaksDirectoryLister.Files);
+	for (const TPair<FString, FDateTime>& PlatformDirectory : PaksDirectoryLister.Directories)
+	{
+		DirectoryInfo.DirectoryTimestamps.Add(PlatformDirectory);
+		FDirectoryStatLister PlatformDirectoryLister;
+		PlatformFile.IterateDirectoryStat(*PlatformDirectory.Key, PlatformDirectoryLister);
+		AddPakFiles(PlatformDirectoryLister.Files);
+	}
+	return DirectoryInfo;
+}
+
+bool FGFPakPluginDirectoryInfo::IsUpToDate() const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	for (const TPair<FString, FDateTime>& DirectoryTimestamp : DirectoryTimestamps)
+	{
+		const FFileStatData DirectoryStat = PlatformFile.GetStatData(*DirectoryTimestamp.Key);
+		const FDateTime ModificationTime = DirectoryStat.bIsValid && DirectoryStat.bIsDirectory ? DirectoryStat.ModificationTime : FDateTime::MinValue();
+		if (ModificationTime != DirectoryTimestamp.Value)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 
 
 void UGFPakPlugin::BeginDestroy()
@@ -137,48 +216,185 @@ bool UGFPakPlugin::LoadPluginData()
 
 	if (UGFPakLoaderSubsystem::GetPakLoaderSettings()->bAutoMountPakPlugins && Status == EGFPakLoaderStatus::Unmounted)
 	{
-		Mount(); //should we return this instead?
+		// Without an up-to-date cache, the Pak Plugin is mounted normally, which creates the cache for the next time
+		if (!UGFPakLoaderSubsystem::GetPakLoaderSettings()->bMountPakPluginsOnDemand || !RegisterOnDemand_Internal())
+		{
+			Mount(); //should we return this instead?
+		}
 	}
 	return Result;
 }
 
 bool UGFPakPlugin::Mount()
 {
+	const bool bWasRegisteredOnDemand = OnDemandRegistration.IsSet();
+	if (bWasRegisteredOnDemand)
+	{
+		// Removed first so loading the packages of this plugin while mounting does not try to mount it again
+		if (UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get())
+		{
+			PakLoaderSubsystem->RemoveOnDemandPakPlugin(this);
+		}
+	}
 	const bool Result = Mount_Internal();
+	if (bWasRegisteredOnDemand && Status < EGFPakLoaderStatus::Mounted)
+	{
+		// The mount failed, so the plugin is registered on demand again for its assets to stay visible and its packages to keep requesting the mount
+		if (OnDemandRegistration.IsSet())
+		{
+			if (UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get())
+			{
+				PakLoaderSubsystem->AddOnDemandPakPlugin(this, OnDemandRegistration->MountPoints);
+			}
+		}
+		else if (!PluginAssetRegistry.IsSet() && !PluginAssetsIndex.IsSet())
+		{
+			// Unmount_Internal removed the registered assets while cleaning up the failed mount, so they are registered again from the cache
+			RegisterOnDemand_Internal();
+		}
+	}
 	BroadcastOnStatusChange(Status);
+	if (Status >= EGFPakLoaderStatus::Mounted)
+	{
+		LastAccessTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed); // A freshly mounted Pak Plugin is not considered idle
+	}
 	if (bHasUPlugin && bIsGameFeaturesPlugin && Status == EGFPakLoaderStatus::Mounted && UGFPakLoaderSubsystem::GetPakLoaderSettings()->bAutoActivateGameFeatures)
 	{
 		const FAssetData* GFDataAsset = UGFPakPlugin::GetGameFeatureData();
 		UGameFeatureData* GFData = Cast<UGameFeatureData>(GFDataAsset->GetAsset());
-		if (ensure(GFData))
+		if (ensure(GFData) && BuiltInInitialFeatureState == EBuiltInAutoState::Active)
 		{
-			TSharedPtr<FJsonObject> PluginDescriptorJsonObject;
-#if WITH_EDITOR
-			PluginDescriptorJsonObject = PluginDescriptor.CachedJson;
-#else
-			FText OutFailReason;
-			FString JsonText;
-			if (FFileHelper::LoadFileToString(JsonText, *UPluginPath))
+			if (UGFPakLoaderSubsystem::GetPakLoaderSettings()->bActivateGameFeaturesOnFirstAccess)
 			{
-				TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
-				if (!FJsonSerializer::Deserialize(Reader, PluginDescriptorJsonObject) || !PluginDescriptorJsonObject.IsValid())
-				{
-					PluginDescriptorJsonObject.Reset();
-				}
+				UE_LOG(LogGFPakLoader, Verbose, TEXT("The GameFeature of the Pak Plugin '%s' will be activated the first time its content is accessed"), *PluginName)
+				bWaitingForFirstAccess = true;
 			}
-#endif
-			if (PluginDescriptorJsonObject)
+			// The subsystem activates the Pak Plugins mounted in the same frame together, in the order of their dependencies
+			else if (UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get())
+			{
+				PakLoaderSubsystem->ScheduleGameFeatureActivation(this);
+			}
+		}
+	}
+	// Preloading would open the plugin files and count as the first access
+	if (bHasUPlugin && bIsGameFeaturesPlugin && Status == EGFPakLoaderStatus::Mounted && !bWaitingForFirstAccess && UGFPakLoaderSubsystem::GetPakLoaderSettings()->bPreloadGameFeatureAssets)
+	{
+		PreloadGameFeatureAssets();
+	}
+	return Result;
+}
+
+void UGFPakPlugin::NotifyContentAccessed()
+{
+	LastAccessTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+	if (!bWaitingForFirstAccess.exchange(false))
+	{
+		return;
+	}
+	
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UGFPakPlugin>(this)]()
+	{
+		UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+		if (WeakThis.IsValid() && WeakThis->Status == EGFPakLoaderStatus::Mounted && PakLoaderSubsystem)
+		{
+			UE_LOG(LogGFPakLoader, Log, TEXT("The content of the Pak Plugin '%s' was accessed for the first time, activating its GameFeature"), *WeakThis->PluginName)
+			PakLoaderSubsystem->ScheduleGameFeatureActivation(WeakThis.Get());
+		}
+	});
+}
+
+void UGFPakPlugin::PreloadGameFeatureAssets()
+{
+	const FAssetData* GameFeatureDataAsset = GetGameFeatureData();
+	if (!GameFeatureDataAsset)
+	{
+		return;
+	}
+	
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("Preloading the GameFeatureData '%s' of the Pak Plugin '%s'..."), *GameFeatureDataAsset->GetObjectPathString(), *PluginName)
+	// The primary assets to preload are declared in the GameFeatureData, so they can only be requested once it is loaded
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(GameFeatureDataAsset->GetSoftObjectPath(),
+		FStreamableDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (Status >= EGFPakLoaderStatus::Mounted && !PreloadHandles.IsEmpty()) // Still mounted and not released
 			{
-				EBuiltInAutoState InitialState = UGameFeaturesSubsystem::DetermineBuiltInInitialFeatureState(PluginDescriptorJsonObject, this->PluginName);
-				if (InitialState == EBuiltInAutoState::Active)
+				PreloadPrimaryAssets();
+			}
+		}), FStreamableManager::DefaultAsyncLoadPriority, false, false, FString::Printf(TEXT("Preload GameFeatureData %s"), *PluginName));
+	if (Handle)
+	{
+		PreloadHandles.Add(MoveTemp(Handle));
+	}
+}
+
+void UGFPakPlugin::PreloadPrimaryAssets()
+{
+	const FAssetData* GameFeatureDataAsset = GetGameFeatureData();
+	const UGameFeatureData* GFData = GameFeatureDataAsset ? Cast<UGameFeatureData>(GameFeatureDataAsset->FastGetAsset(false)) : nullptr;
+	if (!GFData)
+	{
+		return;
+	}
+	
+	const TArray<FName>& PreloadedAssetBundles = UGFPakLoaderSubsystem::GetPakLoaderSettings()->PreloadedAssetBundles;
+	TArray<FSoftObjectPath> AssetsToPreload;
+	for (const FPrimaryAssetTypeInfo& PrimaryAssetTypeInfo : GFData->GetPrimaryAssetTypesToScan())
+	{
+		if (PrimaryAssetTypeInfo.bHasBlueprintClasses) // The assets are Blueprints of the base class, which the plugin assets cache cannot find by class
+		{
+			continue;
+		}
+		const FTopLevelAssetPath AssetBaseClass = PrimaryAssetTypeInfo.AssetBaseClass.ToSoftObjectPath().GetAssetPath();
+		for (const FAssetData* AssetData : GetPluginAssetsOfClass(AssetBaseClass, false))
+		{
+			AssetsToPreload.Add(AssetData->GetSoftObjectPath());
+			if (PreloadedAssetBundles.IsEmpty())
+			{
+				continue;
+			}
+			if (const auto AssetBundles = AssetData->GetTaggedAssetBundles())
+			{
+				for (const FAssetBundleEntry& AssetBundle : AssetBundles->Bundles)
 				{
-					const auto EmptyLambda = FOperationCompleted::CreateLambda([](const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>& Result){});
-					ActivateGameFeature(EmptyLambda);
+					if (PreloadedAssetBundles.Contains(AssetBundle.BundleName))
+					{
+						for (const FTopLevelAssetPath& BundleAssetPath : AssetBundle.AssetPaths)
+						{
+							AssetsToPreload.Emplace(BundleAssetPath);
+						}
+					}
 				}
 			}
 		}
 	}
-	return Result;
+	if (AssetsToPreload.IsEmpty())
+	{
+		return;
+	}
+	
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("Preloading %d primary assets and asset bundles of the Pak Plugin '%s'..."), AssetsToPreload.Num(), *PluginName)
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetsToPreload), FStreamableDelegate(),
+		FStreamableManager::DefaultAsyncLoadPriority, false, false, FString::Printf(TEXT("Preload Primary Assets %s"), *PluginName));
+	if (Handle)
+	{
+		PreloadHandles.Add(MoveTemp(Handle));
+	}
+}
+
+void UGFPakPlugin::ReleasePreloadHandles()
+{
+	for (const TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+	{
+		if (Handle->IsLoadingInProgress())
+		{
+			Handle->CancelHandle();
+		}
+		else
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+	PreloadHandles.Empty();
 }
 
 void UGFPakPlugin::ActivateGameFeature(const FOperationCompleted& CompleteDelegate)
@@ -207,6 +423,13 @@ void UGFPakPlugin::DeactivateGameFeature(const FOperationCompleted& CompleteDele
 		}));
 }
 
+bool UGFPakPlugin::RegisterOnDemand()
+{
+	const bool Result = RegisterOnDemand_Internal();
+	BroadcastOnStatusChange(Status);
+	return Result;
+}
+
 bool UGFPakPlugin::Unmount()
 {
 	const bool Result = Unmount_Internal();
@@ -225,6 +448,15 @@ bool UGFPakPlugin::GetAllPluginAssets(TArray<FAssetData>& Paths, bool bIncludeCo
 {
 	if (Status >= EGFPakLoaderStatus::Mounted && MountedPakFile != nullptr)
 	{
+		if (PluginAssetsIndex.IsSet())
+		{
+			Paths.Empty();
+			for (const TPair<FTopLevelAssetPath, TArray<FSoftObjectPath>>& ClassAssets : PluginAssetsIndex->AssetsByClass)
+			{
+				GetAssetsFromAssetRegistry(ClassAssets.Value, Paths, bIncludeCookGeneratedAssets);
+			}
+			return true;
+		}
 		if (!bIncludeCookGeneratedAssets)
 		{
 			FARCompiledFilter Filter;
@@ -243,58 +475,344 @@ bool UGFPakPlugin::GetAllPluginAssets(TArray<FAssetData>& Paths, bool bIncludeCo
 
 bool UGFPakPlugin::GetPluginAssetsOfClass(const UClass* Class, TArray<FAssetData>& Paths, bool bIncludeCookGeneratedAssets)
 {
-	if (IsValid(Class) && Status >= EGFPakLoaderStatus::Mounted && ensure(PluginAssetRegistry.IsSet()))
+	if (IsValid(Class) && Status >= EGFPakLoaderStatus::Mounted && ensure(PluginAssetRegistry.IsSet() || PluginAssetsIndex.IsSet()))
 	{
-		FARCompiledFilter Filter;
-		Filter.ClassPaths.Add(Class->GetClassPathName());
-		if (!bIncludeCookGeneratedAssets)
+		const TArray<const FAssetData*>& ClassAssets = GetPluginAssetsOfClass(Class->GetClassPathName(), bIncludeCookGeneratedAssets);
+		Paths.Reset(ClassAssets.Num());
+		for (const FAssetData* AssetData : ClassAssets)
 		{
-			Filter.WithoutPackageFlags = PKG_CookGenerated;
+			Paths.Add(*AssetData);
 		}
-		return PluginAssetRegistry->GetAssets(Filter,{},Paths );
+		return true;
 	}
 	UE_LOG(LogGFPakLoader, Warning, TEXT("Tried to retrieve the list of files from the non-Mounted Pak Plugin '%s'"), *PakPluginDirectory)
 	Paths.Empty();
 	return false;
 }
 
-const TArray<const FAssetData*>& UGFPakPlugin::GetPluginAssetsOfClass(const FTopLevelAssetPath& ClassPathName)
+const TArray<const FAssetData*>& UGFPakPlugin::GetPluginAssetsOfClass(const FTopLevelAssetPath& ClassPathName, bool bIncludeCookGeneratedAssets)
 {
-	if (Status >= EGFPakLoaderStatus::Mounted && ensure(PluginAssetRegistry.IsSet()))
+	if (Status < EGFPakLoaderStatus::Mounted || !ensure(PluginAssetRegistry.IsSet() || PluginAssetsIndex.IsSet()))
 	{
-		return PluginAssetRegistry->GetAssetsByClassPathName(ClassPathName);
+		return EmptyAssetsData;
 	}
-	return EmptyAssetsData;
+	
+	TUniquePtr<FClassAssetsCache>& ClassAssets = ClassAssetsCache.FindOrAdd(ClassPathName);
+	if (!ClassAssets)
+	{
+		ClassAssets = MakeUnique<FClassAssetsCache>();
+		if (PluginAssetsIndex.IsSet())
+		{
+			if (const TArray<FSoftObjectPath>* AssetPaths = PluginAssetsIndex->AssetsByClass.Find(ClassPathName))
+			{
+				GetAssetsFromAssetRegistry(*AssetPaths, ClassAssets->AssetsData, true);
+				ClassAssets->Assets.Reserve(ClassAssets->AssetsData.Num());
+				for (const FAssetData& AssetData : ClassAssets->AssetsData)
+				{
+					ClassAssets->Assets.Add(&AssetData);
+				}
+			}
+		}
+		else
+		{
+			ClassAssets->Assets = PluginAssetRegistry->GetAssetsByClassPathName(ClassPathName);
+		}
+		ClassAssets->AssetsWithoutCookGenerated.Reserve(ClassAssets->Assets.Num());
+		for (const FAssetData* AssetData : ClassAssets->Assets)
+		{
+			if ((AssetData->PackageFlags & PKG_CookGenerated) == 0)
+			{
+				ClassAssets->AssetsWithoutCookGenerated.Add(AssetData);
+			}
+		}
+	}
+	return bIncludeCookGeneratedAssets ? ClassAssets->Assets : ClassAssets->AssetsWithoutCookGenerated;
 }
 
-const FAssetData* UGFPakPlugin::GetGameFeatureData() const
+const FAssetData* UGFPakPlugin::FindGameFeatureData() const
 {
 	if (!PluginAssetRegistry)
 	{
 		return nullptr;
 	}
 	
-	TArray<const FAssetData*> AllGameFeaturesData = PluginAssetRegistry->GetAssetsByClassPathName(UGameFeatureData::StaticClass()->GetClassPathName());
-	const FAssetData** GameFeaturesData = Algo::FindByPredicate(AllGameFeaturesData, [](const FAssetData* AssetData)
+	// The UGameFeatureData is expected at the root of the plugin Content directory, with the same name as the plugin, ex: '/my-plugin-name/my-plugin-name'
+	const TArray<const FAssetData*>& AllGameFeaturesData = PluginAssetRegistry->GetAssetsByClassPathName(UGameFeatureData::StaticClass()->GetClassPathName());
+	const FAssetData* const* GameFeaturesData = Algo::FindByPredicate(AllGameFeaturesData, [](const FAssetData* AssetData)
 	{
 		if (ensure(AssetData))
 		{
-			const FString PackagePath = AssetData->PackagePath.ToString().Replace(TEXT("/"), TEXT(""));;
-			const FString AssetName = AssetData->AssetName.ToString();
-			return PackagePath == AssetName;
+			TStringBuilder<256> ExpectedPackagePath;
+			ExpectedPackagePath << TEXT('/') << AssetData->AssetName;
+			return AssetData->PackagePath == FName(ExpectedPackagePath.ToView());
 		}
 		return false;
 	});
 	return GameFeaturesData ? *GameFeaturesData : nullptr;
 }
 
+TSharedPtr<const FGFPakFilenameMap> UGFPakPlugin::FindPakFilename(FName Filename) const
+{
+	if (bPakFilenamesHidden)
+	{
+		return nullptr;
+	}
+	FRWScopeLock Lock(PakFilenamesMapLock, SLT_ReadOnly);
+	const TSharedPtr<const FGFPakFilenameMap>* PakFilename = PakFilenamesMap.Find(Filename);
+	return PakFilename ? *PakFilename : nullptr;
+}
+
+TMap<FName, TSharedPtr<const FGFPakFilenameMap>> UGFPakPlugin::ExchangePakFilenamesMap(TMap<FName, TSharedPtr<const FGFPakFilenameMap>>&& NewPakFilenamesMap)
+{
+	FRWScopeLock Lock(PakFilenamesMapLock, SLT_Write);
+	TMap<FName, TSharedPtr<const FGFPakFilenameMap>> PreviousPakFilenamesMap = MoveTemp(PakFilenamesMap);
+	PakFilenamesMap = MoveTemp(NewPakFilenamesMap);
+	return PreviousPakFilenamesMap;
+}
+
+bool UGFPakPlugin::ContainsPackage(const FName PackageName) const
+{
+	if (Status < EGFPakLoaderStatus::Mounted)
+	{
+		return false;
+	}
+	if (PluginAssetsIndex)
+	{
+		return PluginAssetsIndex->PackageNames.Contains(PackageName);
+	}
+	return PluginAssetRegistry && PluginAssetRegistry->GetAssetsByPackageName(PackageName).Num() > 0;
+}
+
+bool UGFPakPlugin::ContainsAsset(const FSoftObjectPath& AssetPath) const
+{
+	if (Status < EGFPakLoaderStatus::Mounted)
+	{
+		return false;
+	}
+	if (PluginAssetsIndex)
+	{
+		return PluginAssetsIndex->AssetPaths.Contains(AssetPath);
+	}
+	return PluginAssetRegistry && PluginAssetRegistry->GetAssetByObjectPath(AssetPath) != nullptr;
+}
+
+bool UGFPakPlugin::GetPluginAssetData(const FSoftObjectPath& AssetPath, FAssetData& OutAssetData) const
+{
+	if (Status < EGFPakLoaderStatus::Mounted)
+	{
+		return false;
+	}
+	if (PluginAssetRegistry)
+	{
+		const FAssetData* AssetData = PluginAssetRegistry->GetAssetByObjectPath(AssetPath);
+		if (AssetData)
+		{
+			OutAssetData = *AssetData;
+		}
+		return AssetData != nullptr;
+	}
+	if (!ContainsAsset(AssetPath))
+	{
+		return false;
+	}
+	
+	// Without the PluginAssetRegistry, the data of an overridden asset are the ones the subsystem recorded for this plugin, otherwise they are the ones in the global Asset Registry
+	UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+	if (PakLoaderSubsystem && PakLoaderSubsystem->FindOverriddenAssetData(this, AssetPath, OutAssetData))
+	{
+		return true;
+	}
+	OutAssetData = UAssetManager::Get().GetAssetRegistry().GetAssetByObjectPath(AssetPath, false, false);
+	return OutAssetData.IsValid();
+}
+
+bool UGFPakPlugin::IsContentInUse() const
+{
+	const UGFPakPlugin* PakPlugin = this;
+	return IsContentInUse(MakeArrayView(&PakPlugin, 1))[0];
+}
+
+TArray<bool> UGFPakPlugin::IsContentInUse(TConstArrayView<const UGFPakPlugin*> PakPlugins)
+{
+	TArray<bool> InUse;
+	InUse.Init(false, PakPlugins.Num());
+	
+	// 1. We gather the objects of the loaded packages of each PakPlugin. A rooted object is always in use
+	struct FObjectOwner
+	{
+		int32 PakPluginIndex;
+		// The packages released by unmounting are not considered: the GameFeatureData, held by the GameFeatures Subsystem until the GameFeature is deactivated, and the preloaded assets
+		bool bIsReleased;
+	};
+	TMap<const UObject*, FObjectOwner> ObjectOwners; // The references between the objects of a PakPlugin do not keep it in use
+	TArray<UObject*> PluginObjects;
+	for (int32 Index = 0; Index < PakPlugins.Num(); ++Index)
+	{
+		const UGFPakPlugin* PakPlugin = PakPlugins[Index];
+		TSet<const UPackage*> ReleasedPackages;
+		if (const FAssetData* GameFeatureDataAsset = PakPlugin->GetGameFeatureData())
+		{
+			ReleasedPackages.Add(FindObjectFast<UPackage>(nullptr, GameFeatureDataAsset->PackageName));
+		}
+		for (const TSharedPtr<FStreamableHandle>& Handle : PakPlugin->PreloadHandles)
+		{
+			TArray<UObject*> PreloadedAssets;
+			Handle->GetLoadedAssets(PreloadedAssets);
+			for (const UObject* PreloadedAsset : PreloadedAssets)
+			{
+				if (PreloadedAsset)
+				{
+					ReleasedPackages.Add(PreloadedAsset->GetPackage());
+				}
+			}
+		}
+		
+		bool& bIsInUse = InUse[Index];
+		PakPlugin->ForEachLoadedPackage([Index, &ReleasedPackages, &ObjectOwners, &PluginObjects, &bIsInUse](UPackage* Package)
+		{
+			const bool bIsReleased = ReleasedPackages.Contains(Package);
+			bIsInUse |= !bIsReleased && Package->IsRooted();
+			ObjectOwners.Add(Package, {Index, bIsReleased});
+			ForEachObjectWithPackage(Package, [Index, bIsReleased, &ObjectOwners, &PluginObjects, &bIsInUse](UObject* Object)
+			{
+				ObjectOwners.Add(Object, {Index, bIsReleased});
+				if (!bIsReleased)
+				{
+					bIsInUse |= Object->IsRooted();
+					PluginObjects.Add(Object);
+				}
+				return true;
+			});
+		});
+	}
+	if (PluginObjects.IsEmpty() || !InUse.Contains(false))
+	{
+		return InUse;
+	}
+	
+	// 2. Then we look for the referencers of all the objects in a single pass through all the UObjects
+	const TArray<UObject*> Referencers = FReferencerFinder::GetAllReferencers(PluginObjects, nullptr, EReferencerFinderFlags::SkipInnerReferences);
+	
+	// 3. The PakPlugins referenced by an object which is not theirs are in use. Only the references of the referencers found are gathered
+	for (UObject* Referencer : Referencers)
+	{
+		const FObjectOwner* ReferencerOwner = ObjectOwners.Find(Referencer);
+		TArray<UObject*> ReferencedObjects;
+		FReferenceFinder ReferenceFinder(ReferencedObjects);
+		ReferenceFinder.FindReferences(Referencer);
+		for (const UObject* ReferencedObject : ReferencedObjects)
+		{
+			const FObjectOwner* ReferencedOwner = ObjectOwners.Find(ReferencedObject);
+			if (ReferencedOwner && !ReferencedOwner->bIsReleased && (!ReferencerOwner || ReferencerOwner->PakPluginIndex != ReferencedOwner->PakPluginIndex))
+			{
+				InUse[ReferencedOwner->PakPluginIndex] = true;
+			}
+		}
+	}
+	return InUse;
+}
+
+int64 UGFPakPlugin::GetLoadedPackagesSize() const
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	int64 LoadedPackagesSize = 0;
+	ForEachLoadedPackage([this, AssetRegistry, &LoadedPackagesSize](const UPackage* Package)
+	{
+		const FAssetPackageData* PackageData = PluginAssetRegistry ? PluginAssetRegistry->GetAssetPackageData(Package->GetFName()) : nullptr;
+		if (PackageData)
+		{
+			LoadedPackagesSize += FMath::Max<int64>(PackageData->DiskSize, 0);
+		}
+		else if (AssetRegistry) // The Plugin Asset Registry is not kept in memory, but its package data was added to the global Asset Registry
+		{
+			if (const TOptional<FAssetPackageData> GlobalPackageData = AssetRegistry->GetAssetPackageDataCopy(Package->GetFName()))
+			{
+				LoadedPackagesSize += FMath::Max<int64>(GlobalPackageData->DiskSize, 0);
+			}
+		}
+	});
+	return LoadedPackagesSize;
+}
+
+void UGFPakPlugin::ForEachLoadedPackage(TFunctionRef<void(UPackage* Package)> Callback) const
+{
+	if (Status < EGFPakLoaderStatus::Mounted)
+	{
+		return;
+	}
+	auto CallIfLoaded = [&Callback](const FName PackageName)
+	{
+		if (UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName))
+		{
+			Callback(Package);
+		}
+	};
+	if (PluginAssetsIndex)
+	{
+		for (const FName PackageName : PluginAssetsIndex->PackageNames)
+		{
+			CallIfLoaded(PackageName);
+		}
+	}
+	else if (PluginAssetRegistry)
+	{
+		TSet<FName> PackageNames;
+		PackageNames.Reserve(PluginAssetRegistry->GetNumPackages());
+		PluginAssetRegistry->EnumerateAllAssets([&PackageNames](const FAssetData& AssetData)
+		{
+			PackageNames.Add(AssetData.PackageName);
+		});
+		for (const FName PackageName : PackageNames)
+		{
+			CallIfLoaded(PackageName);
+		}
+	}
+}
+
+void UGFPakPlugin::BuildPluginAssetsIndex()
+{
+	if (!ensure(PluginAssetRegistry.IsSet()))
+	{
+		return;
+	}
+	
+	FPluginAssetsIndex NewPluginAssetsIndex;
+	NewPluginAssetsIndex.PackageNames.Reserve(PluginAssetRegistry->GetNumPackages());
+	PluginAssetRegistry->EnumerateAllAssets([&NewPluginAssetsIndex](const FAssetData& AssetData)
+	{
+		NewPluginAssetsIndex.PackageNames.Add(AssetData.PackageName);
+		NewPluginAssetsIndex.AssetPaths.Add(AssetData.GetSoftObjectPath());
+		NewPluginAssetsIndex.AssetsByClass.FindOrAdd(AssetData.AssetClassPath).Add(AssetData.GetSoftObjectPath());
+	});
+	if (GameFeatureData)
+	{
+		NewPluginAssetsIndex.GameFeatureData = *GameFeatureData;
+	}
+	PluginAssetsIndex = MoveTemp(NewPluginAssetsIndex);
+	GameFeatureData = PluginAssetsIndex->GameFeatureData.GetPtrOrNull();
+}
+
+void UGFPakPlugin::GetAssetsFromAssetRegistry(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetData>& OutAssets, bool bIncludeCookGeneratedAssets) const
+{
+	OutAssets.Reserve(OutAssets.Num() + AssetPaths.Num());
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		FAssetData AssetData;
+		if (GetPluginAssetData(AssetPath, AssetData) && (bIncludeCookGeneratedAssets || (AssetData.PackageFlags & PKG_CookGenerated) == 0))
+		{
+			OutAssets.Add(MoveTemp(AssetData));
+		}
+	}
+}
+
 bool UGFPakPlugin::BroadcastOnStatusChange(EGFPakLoaderStatus NewStatus)
 {
 	if (NewStatus != PreviouslyBroadcastedStatus)
 	{
-		Status = NewStatus;
+		SetStatus(NewStatus);
 		const EGFPakLoaderStatus OldStatus = PreviouslyBroadcastedStatus; 
 		PreviouslyBroadcastedStatus = NewStatus; // we don't know what might happen when we broadcast the event, so we need to update this value first
+		ClassAssetsCache.Reset(); // The assets returned by GetPluginAssetsOfClass might be different with the new status
 		UE_LOG(LogGFPakLoader, Verbose, TEXT("Pak Plugin '%s' broadcasting status change:  '%s' => '%s'"), *PakPluginDirectory, *UEnum::GetValueAsString(OldStatus), *UEnum::GetValueAsString(NewStatus))
 		OnStatusChangedDelegate.Broadcast(this, OldStatus, NewStatus);
 		return true;
@@ -302,12 +820,40 @@ bool UGFPakPlugin::BroadcastOnStatusChange(EGFPakLoaderStatus NewStatus)
 	return false;
 }
 
+#if WITH_EDITOR
+void UGFPakPlugin::SetMountPointAboutToBeMounted(TPair<FString, FString>&& InMountPointAboutToBeMounted)
+{
+	MountPointAboutToBeMounted = MoveTemp(InMountPointAboutToBeMounted);
+	if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
+	{
+		Subsystem->SetPakPluginMountPointAboutToBeMounted(this, MountPointAboutToBeMounted.Key);
+	}
+}
+#endif
+
+void UGFPakPlugin::SetStatus(EGFPakLoaderStatus NewStatus)
+{
+	if (Status != NewStatus)
+	{
+		const EGFPakLoaderStatus OldStatus = Status;
+		Status = NewStatus;
+		if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
+		{
+			Subsystem->OnPakPluginStatusSet(this, OldStatus, NewStatus);
+		}
+	}
+}
+
 bool UGFPakPlugin::IsValidPakPluginDirectory(const FString& InPakPluginDirectory)
 {
 	const FString BaseErrorMessage = GetBaseErrorMessage(TEXT("Validating"));
 	
+	// The facts about the directory layout are gathered once and cached by the subsystem until one of the directories changes
+	UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+	const FGFPakPluginDirectoryInfo DirectoryInfo = PakLoaderSubsystem ? PakLoaderSubsystem->GetPakPluginDirectoryInfo(InPakPluginDirectory) : FGFPakPluginDirectoryInfo::FromDirectory(InPakPluginDirectory);
+	
 	// First, we ensure that the plugin directory exist.
-	if (!FPaths::DirectoryExists(InPakPluginDirectory))
+	if (!DirectoryInfo.bDirectoryExists)
 	{
 		UE_LOG(LogGFPakLoader, Error, TEXT("%s: Directory does not exist"), *BaseErrorMessage)
 		return false;
@@ -317,7 +863,7 @@ bool UGFPakPlugin::IsValidPakPluginDirectory(const FString& InPakPluginDirectory
 	PluginName = FPaths::GetBaseFilename(InPakPluginDirectory);
 	
 	UPluginPath = InPakPluginDirectory / PluginName + TEXT(".uplugin");
-	bHasUPlugin = FPaths::FileExists(UPluginPath);
+	bHasUPlugin = DirectoryInfo.bHasUPlugin;
 	if (!bHasUPlugin)
 	{
 		if (!UGFPakLoaderSubsystem::GetPakLoaderSettings()->bRequireUPluginPaks)
@@ -332,17 +878,14 @@ bool UGFPakPlugin::IsValidPakPluginDirectory(const FString& InPakPluginDirectory
 	}
 
 	// ensure we have the right base directory
-	const FString PluginPaksFolder = InPakPluginDirectory / PaksFolderFromDirectory;
-	if (!FPaths::DirectoryExists(PluginPaksFolder))
+	if (!DirectoryInfo.bHasPaksDirectory)
 	{
 		UE_LOG(LogGFPakLoader, Error, TEXT("%s: Directory does not exist"), *BaseErrorMessage)
 		return false;
 	}
 
 	// then look for the Pak file to load
-	IFileManager& FileManager = IFileManager::Get();
-	TArray<FString> PakFiles;
-	FileManager.FindFilesRecursive(PakFiles, *PluginPaksFolder, TEXT("*.pak"), true, false, false);
+	const TArray<FString>& PakFiles = DirectoryInfo.PakFiles;
 	if (PakFiles.IsEmpty())
 	{
 		UE_LOG(LogGFPakLoader, Error, TEXT("%s: Pak file not found"), *BaseErrorMessage)
@@ -357,7 +900,7 @@ bool UGFPakPlugin::IsValidPakPluginDirectory(const FString& InPakPluginDirectory
 	// and ensure the plugin was not packaged with IO Store for now. todo: handle IO Store
 	PakFilePath = PakFiles[0];
 	const FString UtocPath = FPaths::ChangeExtension(PakFilePath, TEXT(".utoc"));
-	if (FPaths::FileExists(UtocPath))
+	if (DirectoryInfo.UtocFiles.Contains(UtocPath))
 	{
 		UE_LOG(LogGFPakLoader, Error, TEXT("%s: Pak Loader currently does not support packaged plugin with IO Store. Make sure IO Store is turned off in the Project Settings > Packaging."), *BaseErrorMessage)
 		return false;
@@ -400,9 +943,27 @@ bool UGFPakPlugin::LoadPluginData_Internal()
 	}
 	
 	PluginDescriptor = {};
+	BuiltInInitialFeatureState = {};
 	if (bHasUPlugin)
 	{
-		PluginDescriptor.Load(UPluginPath);
+		// We parse the .uplugin only once and resolve the initial GameFeature state from the same Json object, so mounting does not need to read it again
+		FString JsonText;
+		TSharedPtr<FJsonObject> PluginDescriptorJsonObject;
+		FText FailReason;
+		bool bIsDescriptorRead = false;
+		if (FFileHelper::LoadFileToString(JsonText, *UPluginPath))
+		{
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+			if (FJsonSerializer::Deserialize(Reader, PluginDescriptorJsonObject) && PluginDescriptorJsonObject.IsValid())
+			{
+				bIsDescriptorRead = PluginDescriptor.Read(*PluginDescriptorJsonObject, &FailReason);
+#if WITH_EDITOR
+				PluginDescriptor.CachedJson = PluginDescriptorJsonObject;
+#endif
+				BuiltInInitialFeatureState = UGameFeaturesSubsystem::DetermineBuiltInInitialFeatureState(PluginDescriptorJsonObject, PluginName);
+			}
+		}
+		UE_CLOG(!bIsDescriptorRead, LogGFPakLoader, Warning, TEXT("Unable to read the UPlugin descriptor file '%s' of the PakPlugin '%s': %s"), *UPluginPath, *PluginName, *FailReason.ToString())
 	}
 
 	UE_LOG(LogGFPakLoader, Log, TEXT("Loaded the Pak Plugin data for '%s'"), *PakPluginDirectory)
@@ -414,18 +975,12 @@ bool UGFPakPlugin::LoadPluginData_Internal()
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("  PluginPak  : '%s'"), *PakFilePath)
 
 	// Now we check if there are potential issues
-	if (bHasUPlugin && !PluginDescriptor.bExplicitlyLoaded)
+	bIsUPluginExplicitlyLoaded = PluginDescriptor.bExplicitlyLoaded;
+	if (bHasUPlugin && !bIsUPluginExplicitlyLoaded)
 	{
+		// The Plugin Manager only mounts Pak Plugins that are ExplicitlyLoaded. The .uplugin next to the pak is never rewritten, a copy setting ExplicitlyLoaded is registered instead when mounting
 		PluginDescriptor.bExplicitlyLoaded = true;
-		FText FailReason;
-		if (PluginDescriptor.Save(UPluginPath, &FailReason))
-		{
-			UE_LOG(LogGFPakLoader, Warning, TEXT("The UPlugin descriptor file '%s' of the PakPlugin '%s' was adjusted to set ExplicitlyLoaded to true."), *UPluginPath, *PluginName)
-		}
-		else
-		{
-			UE_LOG(LogGFPakLoader, Warning, TEXT("Unable to adjust the UPlugin descriptor file '%s' of the PakPlugin '%s' to set ExplicitlyLoaded to true, the Pak Plugin might not mount. Please adjust the .uplugin manually if you encounter any error."), *UPluginPath, *PluginName)
-		}
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("The UPlugin descriptor file '%s' of the PakPlugin '%s' does not set ExplicitlyLoaded to true, a copy setting it will be registered when mounting: '%s'."), *UPluginPath, *PluginName, *GetRegisteredUPluginPath())
 	}
 
 	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(PluginName))
@@ -484,6 +1039,7 @@ bool UGFPakPlugin::Mount_Internal()
 		return false;
 	}
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Mounted the Pak Plugin '%s'"), *PakFilePath)
+	MountReadBytes = static_cast<FPakFile*>(MountedPakFile)->GetInfo().IndexSize; // Mounting the pak reads its index, the files are only read when used
 	
 	// 4a. Now we need to register the proper MountPoint. The default MountPoint returned by the PakFile is the base folder of all the content that was packaged.
 	// Depending on what was packaged in the plugin (like Engine content), the default mount point could be something like "../../../" or "../../../<project-name>/"
@@ -508,7 +1064,20 @@ bool UGFPakPlugin::Mount_Internal()
 	MountPoint = MountedPakFile->PakGetMountPoint();
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Adjusted Mount Point '%s'"), *MountPoint)
 	
+	// If this pak was unmounted recently and did not change since, we reuse the data derived from its index and its Asset Registry instead of building them again
+	TOptional<UGFPakLoaderSubsystem::FPakRemountData> RemountData = PakLoaderSubsystem->TakePakRemountData(PakFilePath);
+	UE_CLOG(RemountData.IsSet(), LogGFPakLoader, Verbose, TEXT("  Reusing the data of the previous mount of the pak from the Remount Cache"))
+	
 	FString AssetRegistryPath;
+	if (RemountData.IsSet())
+	{
+		AssetRegistryPath = RemountData->AssetRegistryPath;
+	}
+	else if (OnDemandRegistration.IsSet())
+	{
+		AssetRegistryPath = OnDemandRegistration->AssetRegistryPath;
+	}
+	else
 	{
 		// First we look for the AssetRegistry.bin path
 		FPakFilenameFinder FileFinder{ TEXT("AssetRegistry.bin") };
@@ -543,6 +1112,33 @@ bool UGFPakPlugin::Mount_Internal()
 		// Even though the path makes us believe that this plugin is a GameFeaturesPlugin, it might not have the required GameFeatureData, which we check below once we have access to the Asset Registry.
 	}
 	UE_LOG(LogGFPakLoader, Verbose, TEXT("  bIsGameFeaturePlugin: '%s'"), bIsGameFeaturesPlugin ? TEXT("TRUE") : TEXT("FALSE"))
+	
+	// Now that we know where the AssetRegistry.bin is, we start loading it in the background so it overlaps with the registration of the Mount Points
+	// and the creation of the filenames map below. The file is read directly from the mounted pak, so it does not need the plugin to be set as Mounted.
+	struct FAssetRegistryLoadResult
+	{
+		TOptional<FAssetRegistryState> AssetRegistryState;
+		double LoadDuration = 0.0;
+	};
+	TFuture<FAssetRegistryLoadResult> AssetRegistryLoadFuture;
+	if (!RemountData.IsSet() && !OnDemandRegistration.IsSet())
+	{
+		AssetRegistryLoadFuture = Async(EAsyncExecution::TaskGraph, [AssetRegistryPath]()
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			FAssetRegistryLoadOptions LoadOptions;
+			LoadOptions.ParallelWorkers = FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 2, 0, 16); // Leave some cores for the Game Thread and the Rendering Thread
+			
+			FAssetRegistryLoadResult Result;
+			FAssetRegistryState PluginAssetRegistryState;
+			if (FAssetRegistryState::LoadFromDisk(*AssetRegistryPath, LoadOptions, PluginAssetRegistryState))
+			{
+				Result.AssetRegistryState = {MoveTemp(PluginAssetRegistryState)};
+			}
+			Result.LoadDuration = FPlatformTime::Seconds() - StartTime;
+			return Result;
+		});
+	}
 
 	// 4b. Now that we know the path of the plugin folder, we can add the main Plugin mount point if this is a Plugin DLC
 	
@@ -552,7 +1148,7 @@ bool UGFPakPlugin::Mount_Internal()
 		const FString PluginMountPointPath = AssetRegistryFolder / TEXT("Content/");
 		UE_LOG(LogGFPakLoader, Verbose, TEXT("  Adding Mount Point for Pak Plugin:  '%s' => '%s'"), *GetExpectedPluginMountPoint(), *PluginMountPointPath)
 #if WITH_EDITOR
-		MountPointAboutToBeMounted = {GetExpectedPluginMountPoint(), PluginMountPointPath};
+		SetMountPointAboutToBeMounted({GetExpectedPluginMountPoint(), PluginMountPointPath});
 #endif
 		PluginContentMountPoint = PakLoaderSubsystem->AddOrCreateMountPointFromContentPath(PluginMountPointPath);
 		if (PluginContentMountPoint)
@@ -564,21 +1160,33 @@ bool UGFPakPlugin::Mount_Internal()
 			UE_LOG(LogGFPakLoader, Error, TEXT("     => Unable to create the Pak Plugin Mount Point for the content folder: '%s'."), *PluginMountPointPath)
 		}
 #if WITH_EDITOR
-		MountPointAboutToBeMounted = {};
+		SetMountPointAboutToBeMounted({});
 #endif
 	}
 	// 4c. The assets might have been referencing content outside of their own plugin, which should have been packaged in the Pak file too. We need to create a mount point for them
 	{ // Then we look at other possible MountPoints
-		FPakContentFoldersFinder ContentFoldersFinder {MountPoint};
-		MountedPakFile->PakVisitPrunedFilenames(ContentFoldersFinder);
-		if (ContentFoldersFinder.ContentFolders.IsEmpty())
+		if (RemountData.IsSet())
+		{
+			PakContentFolders = MoveTemp(RemountData->ContentFolders);
+		}
+		else if (OnDemandRegistration.IsSet())
+		{
+			PakContentFolders = OnDemandRegistration->ContentFolders;
+		}
+		else
+		{
+			FPakContentFoldersFinder ContentFoldersFinder {MountPoint};
+			MountedPakFile->PakVisitPrunedFilenames(ContentFoldersFinder);
+			PakContentFolders = MoveTemp(ContentFoldersFinder.ContentFolders);
+		}
+		if (PakContentFolders.IsEmpty())
 		{
 			UE_LOG(LogGFPakLoader, Warning, TEXT("  %s: Unable to find any Content folder."), *BaseErrorMessage)
 		}
 		else
 		{
 			UE_LOG(LogGFPakLoader, Verbose, TEXT("  Listing all Pak Plugin Content folders:"))
-			for (const FString& ContentFolder : ContentFoldersFinder.ContentFolders)
+			for (const FString& ContentFolder : PakContentFolders)
 			{
 				UE_LOG(LogGFPakLoader, Verbose, TEXT("   - '%s'"), *ContentFolder)
 				if (!bHasUPlugin || !PluginContentMountPoint || ContentFolder != PluginContentMountPoint->GetContentPath()) // do not try to re-register the main plugin MountPoint
@@ -587,7 +1195,7 @@ bool UGFPakPlugin::Mount_Internal()
 					FString ContentPath;
 					if (const TOptional<FString> MountPointName = FPluginMountPoint::GetMountPointFromContentPath(ContentFolder, &ContentPath))
 					{
-						MountPointAboutToBeMounted = {MountPointName.GetValue(), ContentPath};
+						SetMountPointAboutToBeMounted({MountPointName.GetValue(), ContentPath});
 					}
 #endif
 					if (TSharedPtr<FPluginMountPoint> ContentMountPoint = PakLoaderSubsystem->AddOrCreateMountPointFromContentPath(ContentFolder))
@@ -605,44 +1213,72 @@ bool UGFPakPlugin::Mount_Internal()
 				}
 			}
 #if WITH_EDITOR
-			MountPointAboutToBeMounted = {};
+			SetMountPointAboutToBeMounted({});
 #endif
 		}
+		PakLoaderSubsystem->AddPakPluginMountPointNames(this);
 	}
 	
 	// 4d. As we have the asset registry, we can start loading the assets inside the Asset Registry.
+	// If the plugin was registered on demand, its cached Asset Registry was already added to the global Asset Registry and to the subsystem index by RegisterOnDemand_Internal
+	const bool bWasRegisteredOnDemand = OnDemandRegistration.IsSet();
 	{
 		{
 			// The plugin needs to be temporary set as Mounted so UGFPakLoaderSubsystem::FindMountedPakContainingFile actually find the assets
-			TGuardValue GuardedStatus(Status, EGFPakLoaderStatus::Mounted); //todo: create a "Mounting" state
-			
-			FPakGenerateFilenameMap MountedPakFilenames{OriginalMountPoint, MountPoint};
-			MountedPakFile->PakVisitPrunedFilenames(MountedPakFilenames);
-			PakFilenamesMap = MoveTemp(MountedPakFilenames.PakFilenamesMap); //todo: try to combine with UGFPakLoaderSubsystem::AssetOwners, seems duplicated
+			FTemporaryStatus GuardedStatus(*this, EGFPakLoaderStatus::Mounted); //todo: create a "Mounting" state
 			
-			FAssetRegistryState PluginAssetRegistryState;
-			if (FAssetRegistryState::LoadFromDisk(*AssetRegistryPath, FAssetRegistryLoadOptions(), PluginAssetRegistryState))
+			if (RemountData.IsSet())
+			{
+				ExchangePakFilenamesMap(MoveTemp(RemountData->PakFilenamesMap));
+				PluginAssetRegistry = {MoveTemp(RemountData->AssetRegistryState)};
+				PluginAssetRegistryPath = AssetRegistryPath;
+				RemountData.Reset();
+			}
+			else if (bWasRegisteredOnDemand)
 			{
-				PluginAssetRegistry = {MoveTemp(PluginAssetRegistryState)};
+				FPakGenerateFilenameMap MountedPakFilenames{OriginalMountPoint, MountPoint};
+				MountedPakFile->PakVisitPrunedFilenames(MountedPakFilenames);
+				ExchangePakFilenamesMap(MoveTemp(MountedPakFilenames.PakFilenamesMap));
+			}
+			else
+			{
+				FPakGenerateFilenameMap MountedPakFilenames{OriginalMountPoint, MountPoint};
+				MountedPakFile->PakVisitPrunedFilenames(MountedPakFilenames);
+				ExchangePakFilenamesMap(MoveTemp(MountedPakFilenames.PakFilenamesMap)); //todo: try to combine with UGFPakLoaderSubsystem::AssetOverrides, seems duplicated
+				
+				const double WaitStartTime = FPlatformTime::Seconds();
+				FAssetRegistryLoadResult AssetRegistryLoadResult = AssetRegistryLoadFuture.Consume();
+				const double WaitDuration = FPlatformTime::Seconds() - WaitStartTime;
+				if (AssetRegistryLoadResult.AssetRegistryState.IsSet())
+				{
+					PluginAssetRegistry = MoveTemp(AssetRegistryLoadResult.AssetRegistryState);
+					PluginAssetRegistryPath = AssetRegistryPath;
+					MountReadBytes += FMath::Max<int64>(FPlatformFileManager::Get().GetPlatformFile().FileSize(*AssetRegistryPath), 0);
+				}
+				UE_LOG(LogGFPakLoader, Verbose, TEXT("  AssetRegistry loaded in %.2fms in the background, of which %.2fms were overlapped with the mounting (waited %.2fms)"),
+					AssetRegistryLoadResult.LoadDuration * 1000.0, FMath::Max(0.0, AssetRegistryLoadResult.LoadDuration - WaitDuration) * 1000.0, WaitDuration * 1000.0)
+			}
+			if (bWasRegisteredOnDemand)
+			{
+				// The Mount Points kept by the registration were reused above, so they can be released
+				PluginAssetRegistry = {MoveTemp(OnDemandRegistration->AssetRegistryState)};
+				PluginAssetRegistryPath = AssetRegistryPath;
+				OnDemandRegistration.Reset();
 			}
 		}
 		if (PluginAssetRegistry.IsSet())
 		{
 			UE_LOG(LogGFPakLoader, Verbose, TEXT("  AssetRegistry Loaded from '%s': %d Assets in %d Packages"), *AssetRegistryPath, PluginAssetRegistry->GetNumAssets(), PluginAssetRegistry->GetNumPackages());
 			
-			// We make sure the newly added packages were not marked as empty. This can happen when the assets are deleted via FAssetRegistryModule::AssetDeleted
-			TSet<FName> PackageNames;
-			PluginAssetRegistry->EnumerateAllAssets([&PackageNames](const FAssetData& AssetData)
+			if (!bWasRegisteredOnDemand)
 			{
-				PackageNames.Add(AssetData.PackageName);
-			});
-			AddOrRemovePackagesFromAssetRegistryEmptyPackagesCache(EAddOrRemove::Remove, PackageNames);
-			
-			PakLoaderSubsystem->OnPreAddPluginAssetRegistry(PluginAssetRegistry.GetValue(), this);
-			
-			// Then we add them to the AssetRegistry
-			IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
-			AssetRegistry.AppendState(*PluginAssetRegistry);
+				AddPluginAssetsToAssetRegistry(PluginAssetRegistry.GetValue());
+				if (UGFPakLoaderSubsystem::GetPakLoaderSettings()->bMountPakPluginsOnDemand)
+				{
+					SaveOnDemandCache();
+				}
+				PakLoaderSubsystem->AddPluginToAssetsIndex(PluginAssetRegistry.GetValue(), this);
+			}
 			// Note: in Cooked Packages, Blueprints have 2 assets within the same package: the Blueprint itself and the BlueprintGeneratedClass '_C'.
 			// UE does not support having both in some functions like AssetRegistry.GetAssetsByPackageName, so the default filtering (for cooked packages) will
 			// filter out the BP and keep the class as per UE::AssetRegistry::Utils::ShouldSkipAsset
@@ -656,11 +1292,11 @@ bool UGFPakPlugin::Mount_Internal()
 	}
 	
 	
-	// 4e. Ensure we have a valid GameFeaturesPlugin if we believe it should be one
+	// 4e. Resolve the GameFeatureData once for the lifetime of the mount, and ensure we have a valid GameFeaturesPlugin if we believe it should be one
+	GameFeatureData = FindGameFeatureData();
 	if (bIsGameFeaturesPlugin && ensure(PluginAssetRegistry)) //todo: test changes with GameFeatures plugin
 	{
-		const FAssetData* GameFeaturesData = GetGameFeatureData();
-		if (!GameFeaturesData)
+		if (!GameFeatureData)
 		{
 			UE_LOG(LogGFPakLoader, Warning, TEXT("  %s: The Pak Plugin is a GameFeatures plugin but was not packaged with a UGameFeatureData asset at the root of its Content directory. The GameFeatures specific actions might not work."), *BaseErrorMessage)
 			UE_LOG(LogGFPakLoader, Warning, TEXT("  bIsGameFeaturePlugin: '%s'"), bIsGameFeaturesPlugin ? TEXT("TRUE") : TEXT("FALSE"))
@@ -668,22 +1304,38 @@ bool UGFPakPlugin::Mount_Internal()
 		}
 	}
 
+	// 4f. If the Plugin Asset Registry is not kept in memory, we only keep a lightweight index of the plugin assets, as their data is now in the global Asset Registry
+	if (!UGFPakLoaderSubsystem::GetPakLoaderSettings()->bKeepPluginAssetRegistryInMemory && PluginAssetRegistry.IsSet())
+	{
+		BuildPluginAssetsIndex();
+		PluginAssetRegistry.Reset();
+		ClassAssetsCache.Reset();
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("  Keeping a lightweight index of the %d Packages of the Pak Plugin instead of its Asset Registry"), PluginAssetsIndex->PackageNames.Num())
+	}
+
 	// 5. Register the plugin with the Plugin Manager
-	if (bHasUPlugin)
+	FText WriteFailReason;
+	if (bHasUPlugin && !bIsUPluginExplicitlyLoaded && !WriteExplicitlyLoadedUPlugin(WriteFailReason))
 	{
+		// Failing to write the copy must not fail the mount: the content is mounted by us, only the Plugin Manager and the GameFeatures Subsystem will not know about this plugin
+		UE_LOG(LogGFPakLoader, Warning, TEXT("  Unable to write the ExplicitlyLoaded copy '%s' of the UPlugin '%s', the plugin will not be registered with the Plugin Manager: %s"), *GetRegisteredUPluginPath(), *UPluginPath, *WriteFailReason.ToString())
+	}
+	else if (bHasUPlugin)
+	{
+		const FString RegisteredUPluginPath = GetRegisteredUPluginPath();
 		FText FailReason;
 		{
 			// For UGFPakLoaderSubsystem::RegisterMountPoint to not register the wrong mount point in FPluginManager::MountPluginFromExternalSource, we need to have the plugin status to Mounted
-			TOptionalGuardValue<EGFPakLoaderStatus> TemporaryStatus(Status, EGFPakLoaderStatus::Mounted);
-			PluginInterface = LoadPlugin(UPluginPath, &FailReason);
+			FTemporaryStatus TemporaryStatus(*this, EGFPakLoaderStatus::Mounted);
+			PluginInterface = LoadPlugin(RegisteredUPluginPath, &FailReason);
 		}
 		if (PluginInterface)
 		{
-			UE_LOG(LogGFPakLoader, Log, TEXT("  Successfully loaded plugin from UPlugin '%s'!"), *UPluginPath)
+			UE_LOG(LogGFPakLoader, Log, TEXT("  Successfully loaded plugin from UPlugin '%s'!"), *RegisteredUPluginPath)
 		}
 		else
 		{
-			UE_LOG(LogGFPakLoader, Error, TEXT("  %s: Unable to add the UPlugin '%s' to the plugins list:  '%s'"), *BaseErrorMessage, *UPluginPath, *FailReason.ToString())
+			UE_LOG(LogGFPakLoader, Error, TEXT("  %s: Unable to add the UPlugin '%s' to the plugins list:  '%s'"), *BaseErrorMessage, *RegisteredUPluginPath, *FailReason.ToString())
 			Unmount_Internal();
 			return false;
 		}
@@ -712,6 +1364,7 @@ bool UGFPakPlugin::Mount_Internal()
 void UGFPakPlugin::ActivateGameFeature_Internal(const FOperationCompleted& CompleteDelegate)
 {
 	const FString BaseErrorMessage = GetBaseErrorMessage(TEXT("Activating"));
+	bWaitingForFirstAccess = false;
 	
 	if (Status < EGFPakLoaderStatus::Mounted)
 	{
@@ -757,7 +1410,7 @@ void UGFPakPlugin::ActivateGameFeature_Internal(const FOperationCompleted& Compl
 		{
 			BroadcastOnStatusChange(EGFPakLoaderStatus::ActivatingGameFeature);
 			
-			const FString GFPluginPath = UGameFeaturesSubsystem::GetPluginURL_FileProtocol(UPluginPath);
+			const FString GFPluginPath = UGameFeaturesSubsystem::GetPluginURL_FileProtocol(GetRegisteredUPluginPath());
 			
 			UE_LOG(LogGFPakLoader, Verbose, TEXT("  Calling UGameFeaturesSubsystem::LoadAndActivateGameFeaturePlugin for Pak Plugin '%s'..."), *PluginName)
 			GFSubsystem->LoadAndActivateGameFeaturePlugin(GFPluginPath, FGameFeaturePluginLoadComplete::CreateLambda(
@@ -770,7 +1423,7 @@ void UGFPakPlugin::ActivateGameFeature_Internal(const FOperationCompleted& Compl
 					{
 						if (Result.HasError())
 						{
-							WeakThis->Status = EGFPakLoaderStatus::GameFeatureActivated; //needed even for errors to be sure we are able to deactivate, but no need to broadcast
+							WeakThis->SetStatus(EGFPakLoaderStatus::GameFeatureActivated); //needed even for errors to be sure we are able to deactivate, but no need to broadcast
 							WeakThis->DeactivateGameFeature_Internal(FOperationCompleted::CreateLambda([WeakThis, CompleteDelegate, OriginalResult = Result](const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>& Result)
 							{
 								CompleteDelegate.ExecuteIfBound(false, OriginalResult);
@@ -868,7 +1521,7 @@ void UGFPakPlugin::DeactivateGameFeature_Internal(const FOperationCompleted& Com
 		{
 			BroadcastOnStatusChange(EGFPakLoaderStatus::DeactivatingGameFeature);
 
-			const FString GFPluginPath = UGameFeaturesSubsystem::GetPluginURL_FileProtocol(UPluginPath);
+			const FString GFPluginPath = UGameFeaturesSubsystem::GetPluginURL_FileProtocol(GetRegisteredUPluginPath());
 
 			UE_LOG(LogGFPakLoader, Verbose, TEXT("  Calling UGameFeaturesSubsystem::DeactivateGameFeaturePlugin for Pak Plugin '%s'..."), *PluginName)
 
@@ -985,7 +1638,7 @@ void UGFPakPlugin::UnloadPakPluginObjects_Internal(const FOperationCompleted& Co
 	// }
 
 	// 4. Creation of the unloading lambdas
-	FString GFPluginPath = bHasUPlugin ? UGameFeaturesSubsystem::GetPluginURL_FileProtocol(UPluginPath) : "";
+	FString GFPluginPath = bHasUPlugin ? UGameFeaturesSubsystem::GetPluginURL_FileProtocol(GetRegisteredUPluginPath()) : "";
 	auto UnloadGameFeature = [WeakThis = TWeakObjectPtr<UGFPakPlugin>(this), bNeedGameFeatureUnloading = bNeedGameFeatureUnloading, PluginName = PluginName, GFPluginPath = MoveTemp(GFPluginPath),
 		BackupMountPoints = PakPluginMountPoints, bHasUPlugin = bHasUPlugin, CompleteDelegate]() mutable
 	{
@@ -1049,9 +1702,19 @@ bool UGFPakPlugin::Unmount_Internal()
 	
 	if (Status < EGFPakLoaderStatus::Mounted)
 	{
+		// A Pak Plugin registered on demand only needs its assets to be removed from the Asset Registry
+		if (OnDemandRegistration.IsSet())
+		{
+			UnregisterOnDemand_Internal();
+			return true;
+		}
 		UE_LOG(LogGFPakLoader, Log, TEXT("%s: Trying to unmount a Pak Plugin that is not in a Mounted state."), *BaseErrorMessage)
 		return Status == EGFPakLoaderStatus::Unmounted;
 	}
+	
+	// The preloaded assets must not be kept alive by their handles when the plugin objects are unloaded
+	ReleasePreloadHandles();
+	bWaitingForFirstAccess = false;
 
 	// Do a full Flush before we call the delegates
 	FlushAsyncLoading();
@@ -1096,6 +1759,10 @@ bool UGFPakPlugin::Unmount_Internal()
 			UE_LOG(LogGFPakLoader, Verbose, TEXT("  The pointer to the Pak Plugin '%s' became invalid while the plugin was Unloading its Objects"), *PakFilePath)
 		}
 	}));
+	if (UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get())
+	{
+		PakLoaderSubsystem->RemovePakPluginMountPointNames(this);
+	}
 	PakPluginMountPoints.Empty();
 	
 	FGFPakLoaderPlatformFile* PakPlatformFile = UGFPakLoaderSubsystem::Get() ? UGFPakLoaderSubsystem::Get()->GetGFPakPlatformFile() : nullptr; // We need to ensure the PakPlatformFile is loaded or the following might not work
@@ -1111,13 +1778,32 @@ bool UGFPakPlugin::Unmount_Internal()
 	}
 	UE_LOG(LogGFPakLoader, Log, TEXT("  Unmounted the Pak Plugin '%s'"), *PakFilePath)
 	
+	// The data derived from the pak are kept by the subsystem if the Remount Cache is enabled, as mounting the same pak again would produce the same data
+	UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+	if (PakLoaderSubsystem && PluginAssetRegistry.IsSet() && !PakFilenamesMap.IsEmpty() && UGFPakLoaderSubsystem::GetPakLoaderSettings()->RemountCacheSize > 0)
+	{
+		UGFPakLoaderSubsystem::FPakRemountData RemountData;
+		RemountData.PakFilePath = PakFilePath;
+		RemountData.AssetRegistryPath = PluginAssetRegistryPath;
+		RemountData.ContentFolders = MoveTemp(PakContentFolders);
+		RemountData.PakFilenamesMap = ExchangePakFilenamesMap({});
+		RemountData.AssetRegistryState = MoveTemp(PluginAssetRegistry.GetValue());
+		PakLoaderSubsystem->AddPakRemountData(MoveTemp(RemountData));
+	}
+	
 	MountedPakFile = nullptr;
+	MountReadBytes = 0;
 	PluginAssetRegistry.Reset();
-	PakFilenamesMap.Reset();
+	PluginAssetRegistryPath.Empty();
+	PakContentFolders.Empty();
+	PluginAssetsIndex.Reset();
+	ClassAssetsCache.Reset();
+	GameFeatureData = nullptr;
+	ExchangePakFilenamesMap({});
 
 #if WITH_EDITOR
 	// We are asking the Content Browser to refresh
-	MountPointAboutToBeMounted = {};
+	SetMountPointAboutToBeMounted({});
 	if (UContentBrowserDataSubsystem* ContentBrowserDataSubsystem = IContentBrowserDataModule::Get().GetSubsystem())
 	{
 		ContentBrowserDataSubsystem->SetVirtualPathTreeNeedsRebuild();
@@ -1137,6 +1823,7 @@ void UGFPakPlugin::Deinitialize_Internal()
 	{
 		Unmount_Internal();
 	}
+	UnregisterOnDemand_Internal();
 
 	UE_CLOG(Status != EGFPakLoaderStatus::NotInitialized && Status != EGFPakLoaderStatus::InvalidPluginDirectory, LogGFPakLoader, Log, TEXT("Deinitialized the Pak Plugin '%s'"), *PakPluginDirectory)
 	OnDeinitializingDelegate.Broadcast(this);
@@ -1145,14 +1832,195 @@ void UGFPakPlugin::Deinitialize_Internal()
 	PakFilePath.Empty();
 	UPluginPath.Empty();
 	PluginDescriptor = {};
+	bIsUPluginExplicitlyLoaded = false;
+	BuiltInInitialFeatureState = {};
 	bHasUPlugin = false;
 	bIsGameFeaturesPlugin = false;
 	MountedPakFile = nullptr;
+	MountReadBytes = 0;
 	PluginAssetRegistry.Reset();
-	PakFilenamesMap.Reset();
+	PluginAssetRegistryPath.Empty();
+	PakContentFolders.Empty();
+	PluginAssetsIndex.Reset();
+	ClassAssetsCache.Reset();
+	GameFeatureData = nullptr;
+	ExchangePakFilenamesMap({});
+	ReleasePreloadHandles();
 	BroadcastOnStatusChange(EGFPakLoaderStatus::NotInitialized);
 }
 
+FString UGFPakPlugin::GetOnDemandCacheFolder() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("GFPakLoader/OnDemand") / PluginName;
+}
+
+void UGFPakPlugin::SaveOnDemandCache() const
+{
+	const FFileStatData PakFileStat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*PakFilePath);
+	if (!PakFileStat.bIsValid || PluginAssetRegistryPath.IsEmpty())
+	{
+		return;
+	}
+	
+	const FString CacheFolder = GetOnDemandCacheFolder();
+	const FString CacheFilePath = CacheFolder / TEXT("Cache.json");
+	const FString CachedAssetRegistryPath = CacheFolder / TEXT("AssetRegistry.bin");
+	if (IFileManager::Get().GetTimeStamp(*CacheFilePath) > PakFileStat.ModificationTime && IFileManager::Get().FileExists(*CachedAssetRegistryPath))
+	{
+		return; // The cache was written after the pak was, and is validated against the pak when registering
+	}
+	
+	// The Asset Registry is copied as is from the mounted pak, so it is loaded the same way as the original one
+	IFileManager::Get().MakeDirectory(*CacheFolder, true);
+	if (IFileManager::Get().Copy(*CachedAssetRegistryPath, *PluginAssetRegistryPath) != COPY_OK)
+	{
+		UE_LOG(LogGFPakLoader, Warning, TEXT("  Unable to copy the Asset Registry '%s' of the Pak Plugin '%s' to '%s'. The Pak Plugin will not be registered on demand."), *PluginAssetRegistryPath, *PluginName, *CachedAssetRegistryPath)
+		return;
+	}
+	
+	const TSharedRef<FJsonObject> CacheJsonObject = MakeShared<FJsonObject>();
+	CacheJsonObject->SetStringField(TEXT("PakFilePath"), PakFilePath);
+	CacheJsonObject->SetStringField(TEXT("PakFileSize"), LexToString(PakFileStat.FileSize));
+	CacheJsonObject->SetStringField(TEXT("PakFileTimestamp"), LexToString(PakFileStat.ModificationTime.GetTicks()));
+	CacheJsonObject->SetStringField(TEXT("AssetRegistryPath"), PluginAssetRegistryPath);
+	TArray<TSharedPtr<FJsonValue>> ContentFolders;
+	for (const FString& ContentFolder : PakContentFolders)
+	{
+		ContentFolders.Add(MakeShared<FJsonValueString>(ContentFolder));
+	}
+	CacheJsonObject->SetArrayField(TEXT("ContentFolders"), ContentFolders);
+	
+	FString JsonText;
+	if (!FJsonSerializer::Serialize(CacheJsonObject, TJsonWriterFactory<>::Create(&JsonText)) || !FFileHelper::SaveStringToFile(JsonText, *CacheFilePath))
+	{
+		UE_LOG(LogGFPakLoader, Warning, TEXT("  Unable to save the on demand cache of the Pak Plugin '%s' to '%s'."), *PluginName, *CacheFilePath)
+		return;
+	}
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Saved the on demand cache of the Pak Plugin to '%s'"), *CacheFolder)
+}
+
+FString UGFPakPlugin::GetRegisteredUPluginPath() const
+{
+	if (bIsUPluginExplicitlyLoaded)
+	{
+		return UPluginPath;
+	}
+	return FPaths::ProjectSavedDir() / TEXT("GFPakLoader/Descriptors") / PluginName / PluginName + TEXT(".uplugin");
+}
+
+bool UGFPakPlugin::WriteExplicitlyLoadedUPlugin(FText& OutFailReason) const
+{
+	// The Json of the .uplugin is copied as is instead of saving PluginDescriptor, so the fields the GameFeatures Subsystem reads (like BuiltInInitialFeatureState) are kept.
+	// The plugin content is mounted by us and not from the base directory of the copy, but the Config and Localization folders of the Pak Plugin are not picked up by the Plugin Manager
+	FString JsonText;
+	TSharedPtr<FJsonObject> PluginDescriptorJsonObject;
+	if (!FFileHelper::LoadFileToString(JsonText, *UPluginPath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), PluginDescriptorJsonObject) || !PluginDescriptorJsonObject.IsValid())
+	{
+		OutFailReason = FText::Format(LOCTEXT("FailedToReadUPlugin", "Unable to read the UPlugin '{0}'"), FText::FromString(UPluginPath));
+		return false;
+	}
+	PluginDescriptorJsonObject->SetBoolField(TEXT("ExplicitlyLoaded"), true);
+	
+	const FString RegisteredUPluginPath = GetRegisteredUPluginPath();
+	JsonText.Reset();
+	if (!FJsonSerializer::Serialize(PluginDescriptorJsonObject.ToSharedRef(), TJsonWriterFactory<>::Create(&JsonText)) || !FFileHelper::SaveStringToFile(JsonText, *RegisteredUPluginPath))
+	{
+		OutFailReason = FText::Format(LOCTEXT("FailedToWriteUPlugin", "Unable to write the UPlugin '{0}'"), FText::FromString(RegisteredUPluginPath));
+		return false;
+	}
+	UE_LOG(LogGFPakLoader, Verbose, TEXT("  Registering the ExplicitlyLoaded copy '%s' of the UPlugin '%s'"), *RegisteredUPluginPath, *UPluginPath)
+	return true;
+}
+
+bool UGFPakPlugin::RegisterOnDemand_Internal()
+{
+	UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+	if (OnDemandRegistration.IsSet() || Status != EGFPakLoaderStatus::Unmounted || !PakLoaderSubsystem || !PakLoaderSubsystem->IsReady())
+	{
+		return OnDemandRegistration.IsSet();
+	}
+	
+	// 1. We ensure the cache exists and was made from the same pak
+	const FString CacheFolder = GetOnDemandCacheFolder();
+	FString JsonText;
+	TSharedPtr<FJsonObject> CacheJsonObject;
+	if (!FFileHelper::LoadFileToString(JsonText, *(CacheFolder / TEXT("Cache.json"))) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), CacheJsonObject) || !CacheJsonObject.IsValid())
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("The Pak Plugin '%s' does not have an on demand cache yet and will be mounted"), *PluginName)
+		return false;
+	}
+	int64 PakFileSize = INDEX_NONE;
+	int64 PakFileTicks = 0;
+	LexFromString(PakFileSize, *CacheJsonObject->GetStringField(TEXT("PakFileSize")));
+	LexFromString(PakFileTicks, *CacheJsonObject->GetStringField(TEXT("PakFileTimestamp")));
+	const FFileStatData PakFileStat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*PakFilePath);
+	if (!PakFileStat.bIsValid || CacheJsonObject->GetStringField(TEXT("PakFilePath")) != PakFilePath || PakFileStat.FileSize != PakFileSize || PakFileStat.ModificationTime.GetTicks() != PakFileTicks)
+	{
+		UE_LOG(LogGFPakLoader, Verbose, TEXT("The pak '%s' changed since its on demand cache was saved, the Pak Plugin will be mounted"), *PakFilePath)
+		return false;
+	}
+	
+	FOnDemandRegistration Registration;
+	Registration.AssetRegistryPath = CacheJsonObject->GetStringField(TEXT("AssetRegistryPath"));
+	CacheJsonObject->TryGetStringArrayField(TEXT("ContentFolders"), Registration.ContentFolders);
+	if (!FAssetRegistryState::LoadFromDisk(*(CacheFolder / TEXT("AssetRegistry.bin")), FAssetRegistryLoadOptions(), Registration.AssetRegistryState))
+	{
+		UE_LOG(LogGFPakLoader, Warning, TEXT("Unable to load the cached Asset Registry of the Pak Plugin '%s' from '%s', the Pak Plugin will be mounted"), *PluginName, *CacheFolder)
+		return false;
+	}
+	
+	// 2. We register the same Mount Points as Mount_Internal, so the packages of the plugin resolve to their filenames and the subsystem can mount the pak when they are loaded
+	TSharedPtr<FPluginMountPoint> PluginContentMountPoint{};
+	if (bHasUPlugin)
+	{
+		PluginContentMountPoint = PakLoaderSubsystem->AddOrCreateMountPointFromContentPath(FPaths::GetPath(Registration.AssetRegistryPath) / TEXT("Content/"));
+		if (PluginContentMountPoint)
+		{
+			Registration.MountPoints.Add(PluginContentMountPoint);
+		}
+	}
+	for (const FString& ContentFolder : Registration.ContentFolders)
+	{
+		if (!PluginContentMountPoint || ContentFolder != PluginContentMountPoint->GetContentPath())
+		{
+			if (TSharedPtr<FPluginMountPoint> ContentMountPoint = PakLoaderSubsystem->AddOrCreateMountPointFromContentPath(ContentFolder))
+			{
+				Registration.MountPoints.Add(MoveTemp(ContentMountPoint));
+			}
+		}
+	}
+	
+	// 3. Then we add the assets to the Asset Registry and to the subsystem index, and let the subsystem know which packages need this pak to be mounted
+	AddPluginAssetsToAssetRegistry(Registration.AssetRegistryState);
+	PakLoaderSubsystem->AddPluginToAssetsIndex(Registration.AssetRegistryState, this);
+	PakLoaderSubsystem->AddOnDemandPakPlugin(this, Registration.MountPoints);
+	
+	UE_LOG(LogGFPakLoader, Log, TEXT("Registered the Pak Plugin '%s' on demand: %d Assets in %d Packages. Its pak will be mounted when one of its packages is loaded"),
+		*PluginName, Registration.AssetRegistryState.GetNumAssets(), Registration.AssetRegistryState.GetNumPackages())
+	OnDemandRegistration = MoveTemp(Registration);
+	return true;
+}
+
+void UGFPakPlugin::UnregisterOnDemand_Internal()
+{
+	if (!OnDemandRegistration.IsSet())
+	{
+		return;
+	}
+	
+	UE_LOG(LogGFPakLoader, Log, TEXT("Unregistering the Pak Plugin '%s' registered on demand..."), *PluginName)
+	if (UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get())
+	{
+		PakLoaderSubsystem->RemoveOnDemandPakPlugin(this);
+	}
+	
+	// The assets are removed the same way as the ones of a mounted pak, while the Mount Points are still registered to resolve the package filenames
+	PluginAssetRegistry = {MoveTemp(OnDemandRegistration->AssetRegistryState)};
+	UnregisterPluginAssetsFromAssetRegistry();
+	PluginAssetRegistry.Reset();
+	OnDemandRegistration.Reset();
+}
+
 void UGFPakPlugin::PurgePakPluginContent(const FString& PakPluginName, const TFunctionRef<bool(UObject*)>& ShouldObjectBePurged, bool bMarkAsGarbage)
 {
 	// Inspired by FPackageMigrationContext::CleanInstancedPackages and FDataprepCoreUtils::PurgeObjects
@@ -1873,6 +2741,30 @@ void UGFPakPlugin::AddOrRemovePackagesFromAssetRegistryEmptyPackagesCache(EAddOr
 	});
 }
 
+void UGFPakPlugin::AddPluginAssetsToAssetRegistry(const FAssetRegistryState& AssetRegistryState)
+{
+	UGFPakLoaderSubsystem* PakLoaderSubsystem = UGFPakLoaderSubsystem::Get();
+	if (!ensure(PakLoaderSubsystem))
+	{
+		return;
+	}
+	
+	// We make sure the newly added packages were not marked as empty. This can happen when the assets are deleted via FAssetRegistryModule::AssetDeleted
+	TSet<FName> PackageNames;
+	AssetRegistryState.EnumerateAllAssets([&PackageNames](const FAssetData& AssetData)
+	{
+		PackageNames.Add(AssetData.PackageName);
+	});
+	AddOrRemovePackagesFromAssetRegistryEmptyPackagesCache(EAddOrRemove::Remove, PackageNames);
+	
+	PakLoaderSubsystem->OnPreAddPluginAssetRegistry(AssetRegistryState, this);
+	
+	// Then we add them to the AssetRegistry
+	IAssetRegistry& AssetRegistry = UAssetManager::Get().GetAssetRegistry();
+	AssetRegistry.AppendState(AssetRegistryState);
+	PakLoaderSubsystem->OnPostAddPluginAssetRegistry(this);
+}
+
 void UGFPakPlugin::UnregisterPluginAssetsFromAssetRegistry()
 {
 	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
@@ -1884,9 +2776,21 @@ void UGFPakPlugin::UnregisterPluginAssetsFromAssetRegistry()
 	UE_LOG(LogGFPakLoader, Log, TEXT("Removing Assets from the Asset Registry"))
 	FlushAsyncLoading(); // to be sure we don't have assets to be deleted that are pending load
 	
+	if (!PluginAssetRegistry.IsSet() && !PluginAssetRegistryPath.IsEmpty())
+	{
+		// The Plugin Asset Registry was not kept in memory, so we reload it from the pak which is still mounted at this point
+		FAssetRegistryState PluginAssetRegistryState;
+		if (FAssetRegistryState::LoadFromDisk(*PluginAssetRegistryPath, FAssetRegistryLoadOptions(), PluginAssetRegistryState))
+		{
+			PluginAssetRegistry = {MoveTemp(PluginAssetRegistryState)};
+		}
+		UE_CLOG(!PluginAssetRegistry.IsSet(), LogGFPakLoader, Error, TEXT("Unable to reload the Pak Plugin Asset Registry '%s'. The assets of the Pak Plugin '%s' will not be removed from the Asset Registry"), *PluginAssetRegistryPath, *PluginName)
+	}
+	
 	TSet<FName> PackageNamesToRemove;
 	if (UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get())
 	{
+		Subsystem->RemovePluginFromAssetsIndex(this);
 		if (PluginAssetRegistry.IsSet())
 		{
 			Subsystem->OnPreRemovePluginAssetRegistry(PluginAssetRegistry.GetValue(), this, PackageNamesToRemove);
@@ -1898,22 +2802,61 @@ void UGFPakPlugin::UnregisterPluginAssetsFromAssetRegistry()
 	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
 	FlushRenderingCommands();
 	
+	// The package entries of the assets that were still on disk need to be removed from the Asset Registry. IAssetRegistry does not expose a runtime way to remove
+	// a package directly, but ScanModifiedAssetFiles removes the entries of the files that do not exist anymore without having to read them.
+	// In the Editor, the packages that were loaded in memory have already been removed by IAssetRegistry::PackageDeleted, so they are skipped.
+	TSet<FString> FilenamesToRemove;
+	TSet<FString> PackagePathsToRemove;
 	{
-		TSet<FString> FilenamesToRemove;
+		TSet<FName> PackageNamesStillRegistered;
+		TArray<FAssetData> ExistingPackageAssets;
+		for (const FName& PackageName : PackageNamesToRemove)
+		{
+			ExistingPackageAssets.Reset();
+			if (AssetRegistry->GetAssetsByPackageName(PackageName, ExistingPackageAssets, false, false) && !ExistingPackageAssets.IsEmpty())
+			{
+				PackageNamesStillRegistered.Add(PackageName);
+			}
+			PackagePathsToRemove.Add(FPaths::GetPath(PackageName.ToString()));
+		}
 		for (const TTuple<FName, TSharedPtr<const FGFPakFilenameMap>>& Entry : PakFilenamesMap)
 		{
-			if (Entry.Value && !Entry.Value->MountedPackageName.IsNone() && PackageNamesToRemove.Contains(Entry.Value->MountedPackageName))
+			if (Entry.Value && !Entry.Value->MountedPackageName.IsNone() && PackageNamesStillRegistered.Contains(Entry.Value->MountedPackageName))
 			{
 				FilenamesToRemove.Add(Entry.Value->ProjectAdjustedFullFilename);
 			}
 		}
-		const TArray<FString> Filenames = FilenamesToRemove.Array();
-		AssetRegistry->ScanModifiedAssetFiles(Filenames);
+		if (OnDemandRegistration.IsSet()) // The pak was never mounted, so the filenames are resolved from the registered Mount Points instead
+		{
+			for (const FName& PackageName : PackageNamesStillRegistered)
+			{
+				FString Filename;
+				if (FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+				{
+					FilenamesToRemove.Add(Filename);
+				}
+			}
+		}
 	}
-	// ScanModifiedAssetFiles might remove assets from the cache data, so we need to remove paths after
-	for (FName& PackageName : PackageNamesToRemove)
+	
+	if (!FilenamesToRemove.IsEmpty())
+	{
+		// We hide the plugin files from the FGFPakLoaderPlatformFile during the scan so the Asset Registry sees them as deleted instead of re-scanning them.
+		// The PakFilenamesMap itself is left untouched as it is read from the async loading thread
+		bPakFilenamesHidden = true;
+		AssetRegistry->ScanModifiedAssetFiles(FilenamesToRemove.Array());
+		bPakFilenamesHidden = false;
+	}
+	
+	// ScanModifiedAssetFiles might remove assets from the cache data, so we need to remove paths after. Only the paths which do not contain any asset anymore are removed,
+	// as a path can be shared with other packages, including Base Game packages that were overriden by this plugin
+	for (const FString& PackagePath : PackagePathsToRemove)
 	{
-		FString PackagePath = FPaths::GetPath(PackageName.ToString());
+		if (AssetRegistry->HasAssets(FName(PackagePath), true))
+		{
+			UE_LOG(LogGFPakLoader, VeryVerbose, TEXT(" - Keeping the Path '%s' as it still contains assets"), *PackagePath)
+			continue;
+		}
 		const bool bResult = AssetRegistry->RemovePath(PackagePath);
 		UE_CLOG(bResult, LogGFPakLoader, Verbose, TEXT(" - Removed the Path '%s'"), *PackagePath)
 		UE_CLOG(!bResult, LogGFPakLoader, Verbose, TEXT(" - ! Unable to remove the Path '%s' !"), *PackagePath)
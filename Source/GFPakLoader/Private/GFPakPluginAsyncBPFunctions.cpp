@@ -3,6 +3,7 @@
 
 #include "GFPakPluginAsyncBPFunctions.h"
 
+#include "GFPakLoaderSubsystem.h"
 #include "GFPakPlugin.h"
 
 UGFPakPluginActivateGameFeatureAsync* UGFPakPluginActivateGameFeatureAsync::GFPakPluginActivateGameFeatureAsync(UGFPakPlugin* GFPakPlugin, UGFPakPlugin*& OutGFPakPlugin)
@@ -118,3 +119,126 @@ void UGFPakPluginDeactivateGameFeatureAsync::ReportFailed()
 	OnFailed.Broadcast();
 	SetReadyToDestroy();
 }
+
+
+
+UGFPakPluginsActivateGameFeaturesAsync* UGFPakPluginsActivateGameFeaturesAsync::GFPakPluginsActivateGameFeaturesAsync(const TArray<UGFPakPlugin*>& GFPakPlugins)
+{
+	UGFPakPluginsActivateGameFeaturesAsync* AsyncAction = NewObject<UGFPakPluginsActivateGameFeaturesAsync>();
+	AsyncAction->PakPlugins = GFPakPlugins;
+	for (UGFPakPlugin* GFPakPlugin : GFPakPlugins)
+	{
+		if (IsValid(GFPakPlugin) && IsValid(GFPakPlugin->GetWorld()))
+		{
+			AsyncAction->RegisterWithGameInstance(GFPakPlugin->GetWorld()->GetGameInstance());
+			break;
+		}
+	}
+	return AsyncAction;
+}
+
+void UGFPakPluginsActivateGameFeaturesAsync::Activate()
+{
+	UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get();
+	if (!Subsystem)
+	{
+		OnFailed.Broadcast({}, 0.0);
+		SetReadyToDestroy();
+		return;
+	}
+	
+	Subsystem->ActivateGameFeatures(PakPlugins, FBatchOperationCompleted::CreateWeakLambda(this, [this](const TArray<FGFPakPluginOperationResult>& Results, double TotalSeconds)
+	{
+		const bool bAllSuccessful = !Results.ContainsByPredicate([](const FGFPakPluginOperationResult& Result) { return !Result.bSuccessful; });
+		if (bAllSuccessful)
+		{
+			OnActivated.Broadcast(Results, TotalSeconds);
+		}
+		else
+		{
+			OnFailed.Broadcast(Results, TotalSeconds);
+		}
+		SetReadyToDestroy();
+	}));
+}
+
+
+
+UGFPakPluginsDeactivateGameFeaturesAsync* UGFPakPluginsDeactivateGameFeaturesAsync::GFPakPluginsDeactivateGameFeaturesAsync(const TArray<UGFPakPlugin*>& GFPakPlugins)
+{
+	UGFPakPluginsDeactivateGameFeaturesAsync* AsyncAction = NewObject<UGFPakPluginsDeactivateGameFeaturesAsync>();
+	AsyncAction->PakPlugins = GFPakPlugins;
+	for (UGFPakPlugin* GFPakPlugin : GFPakPlugins)
+	{
+		if (IsValid(GFPakPlugin) && IsValid(GFPakPlugin->GetWorld()))
+		{
+			AsyncAction->RegisterWithGameInstance(GFPakPlugin->GetWorld()->GetGameInstance());
+			break;
+		}
+	}
+	return AsyncAction;
+}
+
+void UGFPakPluginsDeactivateGameFeaturesAsync::Activate()
+{
+	UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get();
+	if (!Subsystem)
+	{
+		OnFailed.Broadcast({}, 0.0);
+		SetReadyToDestroy();
+		return;
+	}
+	
+	Subsystem->DeactivateGameFeatures(PakPlugins, FBatchOperationCompleted::CreateWeakLambda(this, [this](const TArray<FGFPakPluginOperationResult>& Results, double TotalSeconds)
+	{
+		const bool bAllSuccessful = !Results.ContainsByPredicate([](const FGFPakPluginOperationResult& Result) { return !Result.bSuccessful; });
+		if (bAllSuccessful)
+		{
+			OnDeactivated.Broadcast(Results, TotalSeconds);
+		}
+		else
+		{
+			OnFailed.Broadcast(Results, TotalSeconds);
+		}
+		SetReadyToDestroy();
+	}));
+}
+
+
+
+UGFPakPluginScheduleMountAsync* UGFPakPluginScheduleMountAsync::GFPakPluginScheduleMountAsync(UGFPakPlugin* GFPakPlugin, EGFPakMountPriority MountPriority, UGFPakPlugin*& OutGFPakPlugin)
+{
+	UGFPakPluginScheduleMountAsync* AsyncAction = NewObject<UGFPakPluginScheduleMountAsync>();
+	AsyncAction->PakPlugin = GFPakPlugin;
+	AsyncAction->Priority = MountPriority;
+	OutGFPakPlugin = GFPakPlugin;
+	if (IsValid(GFPakPlugin) && IsValid(GFPakPlugin->GetWorld()))
+	{
+		AsyncAction->RegisterWithGameInstance(GFPakPlugin->GetWorld()->GetGameInstance());
+	}
+	return AsyncAction;
+}
+
+void UGFPakPluginScheduleMountAsync::Activate()
+{
+	UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get();
+	if (!Subsystem || !IsValid(PakPlugin))
+	{
+		OnFailed.Broadcast();
+		SetReadyToDestroy();
+		return;
+	}
+	
+	Subsystem->ScheduleMount(PakPlugin, Priority, FOperationCompleted::CreateWeakLambda(this, [this](const bool bSuccessful, const TOptional<UE::GameFeatures::FResult>&)
+	{
+		if (bSuccessful && IsValid(PakPlugin))
+		{
+			OnMounted.Broadcast();
+		}
+		else
+		{
+			OnFailed.Broadcast();
+		}
+		SetReadyToDestroy();
+	}));
+}
@@ -57,7 +57,7 @@ public:
 	 * @param OriginalFilename 
 	 * @return 
 	 */
-	static FString GetPakAdjustedFilename(const TCHAR* OriginalFilename, bool* bFoundInPak = nullptr);
+	static FString GetPakAdjustedFilename(const TCHAR* OriginalFilename, bool* bFoundInPak = nullptr, bool bIsOpeningFile = false);
 	
 	// IPlatformFile
 	virtual bool ShouldBeUsed(IPlatformFile* Inner, const TCHAR* CmdLine) const override { return true; }
@@ -26,7 +26,6 @@ public:
 #endif
 	//~End UDeveloperSettings
 
-	//todo: add a directory watcher and an option to auto watch the PakLoadPath
 	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Settings")
 	void SetPakLoadPath(const FString& Path);
 	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader Settings")
@@ -68,6 +67,112 @@ public:
 	 */
 	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=6), AdvancedDisplay)
 	bool bEnsureWorldIsLoadedInMemoryBeforeLoadingMap = true;
+	/**
+	 * If true, each mounted Pak Plugin keeps its own copy of its Asset Registry in memory, on top of the assets added to the global Asset Registry.
+	 * If false, only a lightweight index of the plugin assets is kept and the plugin asset queries are resolved with the global Asset Registry,
+	 * which saves the memory of a second copy of the assets data. The Pak Plugin Asset Registry is then reloaded from the pak when unmounting.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=7), AdvancedDisplay)
+	bool bKeepPluginAssetRegistryInMemory = true;
+	/**
+	 * The Asset Registry tags whose values are indexed by the GFPakLoaderSubsystem for all the mounted Pak Plugins, allowing fast queries with UGFPakLoaderSubsystem::GetPakAssetsWithTagValue.
+	 * Only applies to the Pak Plugins mounted after the change.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=8), AdvancedDisplay)
+	TArray<FName> IndexedAssetTags;
+	/**
+	 * The number of unmounted Pak Plugins for which the data derived from the pak (the filenames map, the Content folders and the Asset Registry) are kept in memory,
+	 * so mounting them again skips the pak index walks and the Asset Registry deserialization as long as the pak file did not change. 0 disables the Remount Cache.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=9, ClampMin=0), AdvancedDisplay)
+	int32 RemountCacheSize = 0;
+	/**
+	 * If true, the GFPakLoaderSubsystem watches the StartupPakLoadDirectory once started. Only the Pak Plugin folders that were added or changed are validated, added and mounted,
+	 * and the Pak Plugins whose folder was deleted are removed, instead of rescanning the whole folder with AddPakPluginFolder.
+	 * Uses the DirectoryWatcher in Editor (inotify on Linux), and polls the timestamps of the Pak Plugin folders otherwise.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=10))
+	bool bWatchPakLoadPath = false;
+	/**
+	 * The time in seconds a changed Pak Plugin folder needs to stay unchanged before being processed by the PakLoadPath watcher, so a pak still being copied is not mounted.
+	 * Also the interval at which the PakLoadPath is polled when the DirectoryWatcher is not available, which costs one stat call, plus the stat calls of the pak files of the changed folders being debounced.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=11, ClampMin=0, Units="s", EditCondition="bWatchPakLoadPath"), AdvancedDisplay)
+	float PakLoadPathWatchDebounceSeconds = 1.f;
+	/**
+	 * When the DirectoryWatcher is not available, the interval at which the known Pak Plugin folders are checked for a changed layout, ex: a pak replaced inside an existing folder.
+	 * Each check costs one stat call per folder of the layout of each Pak Plugin (its folder and its Content/Paks folders), so it is kept much longer than PakLoadPathWatchDebounceSeconds. The added and removed folders are found at each poll of the PakLoadPath.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=12, ClampMin=0, Units="s", EditCondition="bWatchPakLoadPath"), AdvancedDisplay)
+	float PakLoadPathWatchFolderCheckSeconds = 30.f;
+	/**
+	 * The maximum number of GameFeatures being activated at the same time by the GFPakLoaderSubsystem activation scheduler, used by bAutoActivateGameFeatures. 0 for no limit.
+	 * A Pak Plugin is only activated once the Pak Plugins it depends on are activated, and the independent Pak Plugins are activated concurrently.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=13, ClampMin=0), AdvancedDisplay)
+	int32 MaxConcurrentGameFeatureActivations = 4;
+	/**
+	 * If true, once a GameFeatures Pak Plugin is mounted, its GameFeatureData and the primary assets of the PrimaryAssetTypesToScan it declares are loaded asynchronously in the background,
+	 * so a later activation of the GameFeature finds them already loaded. The preloaded assets are released when the Pak Plugin is unmounted.
+	 * Primary asset types made of Blueprint classes are not preloaded.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=14), AdvancedDisplay)
+	bool bPreloadGameFeatureAssets = false;
+	/**
+	 * The asset bundles of the preloaded primary assets to also preload, ex: 'Client' or 'Game'. See bPreloadGameFeatureAssets
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=15, EditCondition="bPreloadGameFeatureAssets"), AdvancedDisplay)
+	TArray<FName> PreloadedAssetBundles;
+	/**
+	 * If true, the GameFeatures auto activated as per bAutoActivateGameFeatures are not activated when the Pak Plugin is mounted, but the first time one of the files of the Pak Plugin is opened,
+	 * or when UGFPakPlugin::NotifyContentAccessed is called. The Pak Plugin stays `Mounted` until then, so only the GameFeatures actually used are activated.
+	 * These Pak Plugins are not preloaded by bPreloadGameFeatureAssets, as preloading would count as an access.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=16, EditCondition="bAutoActivateGameFeatures"), AdvancedDisplay)
+	bool bActivateGameFeaturesOnFirstAccess = false;
+	/**
+	 * If true, the Pak Plugins auto mounted as per bAutoMountPakPlugins are only registered: the copy of their Asset Registry cached in 'Saved/GFPakLoader/OnDemand/'
+	 * is added to the global Asset Registry and their Mount Points are registered, but their pak file is not opened. The pak is mounted the first time one of its packages is loaded,
+	 * so hundreds of Pak Plugins can be advertised at startup without the IO and the file handles of mounting them.
+	 * A Pak Plugin without an up-to-date cache is mounted normally, which creates its cache for the next runs. The registered Pak Plugins stay `Unmounted` until mounted.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=17, EditCondition="bAutoMountPakPlugins"), AdvancedDisplay)
+	bool bMountPakPluginsOnDemand = false;
+	/**
+	 * The maximum number of Pak Plugins mounted at the same time. Above it, the GFPakLoaderSubsystem unmounts the least recently used Pak Plugins. 0 for no limit.
+	 * Only the Pak Plugins idle for PakPluginEvictionMinIdleSeconds and whose loaded content is not in use are unmounted. See UGFPakLoaderSubsystem::EvictLeastRecentlyUsedPakPlugins
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=18, ClampMin=0), AdvancedDisplay)
+	int32 MaxMountedPakPlugins = 0;
+	/**
+	 * The memory used by the loaded packages of the mounted Pak Plugins, estimated from their size on disk, above which the GFPakLoaderSubsystem unmounts the least recently used Pak Plugins. 0 for no budget.
+	 * The size is only computed for the Pak Plugins idle for PakPluginEvictionMinIdleSeconds, the other ones count with the last size computed for them.
+	 * Only the Pak Plugins idle for PakPluginEvictionMinIdleSeconds and whose loaded content is not in use are unmounted. See UGFPakLoaderSubsystem::EvictLeastRecentlyUsedPakPlugins
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=19, ClampMin=0, Units="MB"), AdvancedDisplay)
+	int32 PakPluginsMemoryBudget = 0;
+	/**
+	 * The time since the content of a Pak Plugin was last accessed before it can be unmounted by MaxMountedPakPlugins or PakPluginsMemoryBudget, so a Pak Plugin is not unmounted right after being used.
+	 * This is only a grace period: a Pak Plugin whose loaded content is still in use is never unmounted, whatever the time since its last access.
+	 * If bMountPakPluginsOnDemand is true, the unmounted Pak Plugins are registered on demand again, so their assets stay visible.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=20, ClampMin=0, Units="s"), AdvancedDisplay)
+	float PakPluginEvictionMinIdleSeconds = 60.f;
+	/**
+	 * The disk bandwidth given to the Background mounts scheduled with UGFPakLoaderSubsystem::ScheduleMount, in MB read per second by the mounts: the pak index and the AssetRegistry.bin. 0 for no limit.
+	 * The Background mounts are also held while packages are loading asynchronously, so they do not starve the Async Loading Thread.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=21, ClampMin=0), AdvancedDisplay)
+	float BackgroundMountBandwidth = 16.f;
+	/** The maximum number of Normal mounts scheduled with UGFPakLoaderSubsystem::ScheduleMount started per frame, as mounting is done on the Game Thread. 0 for no limit. */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=22, ClampMin=0), AdvancedDisplay)
+	int32 MaxScheduledMountsPerFrame = 1;
+	/**
+	 * If true, the Pak Plugins mounted or with their GameFeature activated when the GFPakLoaderSubsystem shuts down are saved to 'Saved/GFPakLoader/Session.json',
+	 * and are mounted and activated again when it starts, before the game code asks for them. See UGFPakLoaderSubsystem::RestoreSessionSnapshot
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "GF Pak Loader", meta = (DisplayPriority=23), AdvancedDisplay)
+	bool bRestorePreviousSession = false;
 private:
 	/**
 	 * The Path to the Pak Plugin Directory to load at startup. Relative to the project directory if inside of it, otherwise this is a relative path.
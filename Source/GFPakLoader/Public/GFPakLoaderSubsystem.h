@@ -6,6 +6,8 @@
 #include "GFPakLoaderSettings.h"
 #include "GFPakPlugin.h"
 #include "Algo/Copy.h"
+#include "Containers/StaticArray.h"
+#include "Containers/Ticker.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Subsystems/EngineSubsystem.h"
@@ -14,8 +16,80 @@
 
 class FGFPakLoaderPlatformFile;
 class FPakPlatformFile;
+struct FFileChangeData;
 DECLARE_MULTICAST_DELEGATE_OneParam(FPakPluginEvent, UGFPakPlugin*);
 DECLARE_MULTICAST_DELEGATE(FGFPakLoaderSubsystemEvent);
+DECLARE_MULTICAST_DELEGATE_OneParam(FGameFeatureActivationsEvent, const TArray<UGFPakPlugin*>& /*FailedPakPlugins*/);
+
+/** An asset provided by a mounted Pak Plugin, as returned by the UGFPakLoaderSubsystem asset queries */
+USTRUCT(BlueprintType)
+struct GFPAKLOADER_API FGFPakPluginAsset
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	UGFPakPlugin* Plugin = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	FSoftObjectPath AssetPath;
+};
+
+/** The result of the operation on one Pak Plugin, as returned by UGFPakLoaderSubsystem::ActivateGameFeatures and DeactivateGameFeatures */
+USTRUCT(BlueprintType)
+struct GFPAKLOADER_API FGFPakPluginOperationResult
+{
+	GENERATED_BODY()
+	
+	/** Null if the Pak Plugin was destroyed before the batch completed */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	TObjectPtr<UGFPakPlugin> Plugin = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	bool bSuccessful = false;
+	/** The error returned by the GameFeaturesSubsystem, if any */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	FString Error;
+	/** The time between the start of the batch and the completion of this Pak Plugin, in seconds */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	double CompletionSeconds = 0.0;
+};
+DECLARE_DELEGATE_TwoParams(FBatchOperationCompleted, const TArray<FGFPakPluginOperationResult>& /*Results*/, double /*TotalSeconds*/);
+
+/** The priority of a mount scheduled with UGFPakLoaderSubsystem::ScheduleMount */
+UENUM(BlueprintType)
+enum class EGFPakMountPriority : uint8
+{
+	/** Mounted on the next frame, regardless of the other scheduled mounts */
+	Critical,
+	/** Mounted in the order they were scheduled, at most UGFPakLoaderSettings::MaxScheduledMountsPerFrame per frame */
+	Normal,
+	/** Mounted one at a time when no other mount is waiting and no package is loading asynchronously, within UGFPakLoaderSettings::BackgroundMountBandwidth. Meant for prefetching */
+	Background,
+};
+
+/** The state of the mounts scheduled with UGFPakLoaderSubsystem::ScheduleMount */
+USTRUCT(BlueprintType)
+struct GFPAKLOADER_API FGFPakMountSchedulerStats
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	int32 NumQueuedCriticalMounts = 0;
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	int32 NumQueuedNormalMounts = 0;
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	int32 NumQueuedBackgroundMounts = 0;
+	/** The number of paks mounted by the scheduler since the subsystem started */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	int32 NumCompletedMounts = 0;
+	/** The total size of the paks mounted by the scheduler since the subsystem started, in bytes */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	int64 MountedBytes = 0;
+	/** The number of paks mounted per second, over the last seconds */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	float MountsPerSecond = 0.f;
+	/** The size of the paks mounted per second, over the last seconds, in bytes */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader Subsystem")
+	float MountedBytesPerSecond = 0.f;
+};
 
 /**
  * 
@@ -49,6 +123,8 @@ public:
 	FPakPluginEvent& OnPakPluginAdded() { return OnPakPluginAddedDelegate; }
 	FOnStatusChanged& OnPakPluginStatusChanged() { return OnPakPluginStatusChangedDelegate; }
 	FPakPluginEvent& OnPakPluginRemoved() { return OnPakPluginRemovedDelegate; }
+	/** Called once all the GameFeature activations scheduled with ScheduleGameFeatureActivation are completed, with the PakPlugins which failed to activate */
+	FGameFeatureActivationsEvent& OnScheduledGameFeatureActivationsCompleted() { return OnScheduledGameFeatureActivationsCompletedDelegate; }
 	
 	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader Subsystem", meta=(AdvancedDisplay=1))
 	FString GetDefaultPakPluginFolder() const;
@@ -77,6 +153,51 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem", meta=(AdvancedDisplay=1))
 	UGFPakPlugin* GetOrAddPakPlugin(const FString& InPakPluginPath, bool& bIsNewlyAdded);
+	/**
+	 * Schedules the activation of the GameFeature of the PakPlugin. A scheduled PakPlugin is only activated once the scheduled PakPlugins it depends on, as per its FPluginDescriptor,
+	 * are activated, and at most UGFPakLoaderSettings::MaxConcurrentGameFeatureActivations are activating at the same time.
+	 * The PakPlugins scheduled in the same frame are ordered together, ex: all the PakPlugins auto activated by AddPakPluginFolder.
+	 * @param CompleteDelegate Called when the activation of this PakPlugin is completed
+	 */
+	void ScheduleGameFeatureActivation(UGFPakPlugin* PakPlugin, const FOperationCompleted& CompleteDelegate = {});
+	/** Returns true until all the GameFeature activations scheduled with ScheduleGameFeatureActivation are completed */
+	bool HasScheduledGameFeatureActivations() const { return bHasScheduledGameFeatureActivations; }
+	/**
+	 * Schedules the mounting of the PakPlugin, so many mounts requested during gameplay do not compete with the level streaming for the disk bandwidth. See EGFPakMountPriority
+	 * Called from Blueprints with the async node UGFPakPluginScheduleMountAsync, as the CompleteDelegate cannot be a UFUNCTION parameter.
+	 * @param CompleteDelegate Called once the PakPlugin is mounted or failed to mount
+	 */
+	void ScheduleMount(UGFPakPlugin* PakPlugin, EGFPakMountPriority Priority, const FOperationCompleted& CompleteDelegate = {});
+	/** Returns the number of mounts waiting in each priority queue and the throughput of the mounts scheduled with ScheduleMount */
+	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader Subsystem")
+	FGFPakMountSchedulerStats GetMountSchedulerStats() const;
+	
+	/**
+	 * Saves to GetSessionSnapshotPath which PakPlugins are mounted and which have their GameFeature activated, in the order they were mounted.
+	 * Called on shutdown if UGFPakLoaderSettings::bRestorePreviousSession is true.
+	 * @return Returns true if the snapshot was saved
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	bool SaveSessionSnapshot();
+	/**
+	 * Mounts the PakPlugins saved by SaveSessionSnapshot in the order they were mounted, and then activates the GameFeatures that were activated through ActivateGameFeatures,
+	 * so the independent PakPlugins are activated concurrently. Called on startup if UGFPakLoaderSettings::bRestorePreviousSession is true.
+	 * @return Returns the number of PakPlugins mounted from the snapshot
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	int32 RestoreSessionSnapshot();
+	/** Returns the path of the snapshot saved by SaveSessionSnapshot, ex: '<project>/Saved/GFPakLoader/Session.json' */
+	static FString GetSessionSnapshotPath();
+	/**
+	 * Activates the GameFeatures of all the given PakPlugins, going through ScheduleGameFeatureActivation so the independent PakPlugins are activated concurrently.
+	 * The CompleteDelegate is called once, when all the activations are completed, with the result of each PakPlugin in the order they were given.
+	 */
+	void ActivateGameFeatures(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate);
+	/**
+	 * Deactivates the GameFeatures of all the given PakPlugins concurrently.
+	 * The CompleteDelegate is called once, when all the deactivations are completed, with the result of each PakPlugin in the order they were given.
+	 */
+	void DeactivateGameFeatures(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate);
 
 	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
 	TArray<UGFPakPlugin*> GetPakPlugins() const
@@ -175,59 +296,122 @@ public:
 	}
 	
 
+	template <EComparison Comparison>
+	static bool CompareStatus(EGFPakLoaderStatus PakPluginStatus, EGFPakLoaderStatus Status)
+	{
+		if constexpr (Comparison == EComparison::Equal)
+		{
+			return PakPluginStatus == Status;
+		}
+		else if constexpr (Comparison == EComparison::NotEqual)
+		{
+			return PakPluginStatus != Status;
+		}
+		else if constexpr (Comparison == EComparison::GreaterOrEqual)
+		{
+			return PakPluginStatus >= Status;
+		}
+		else if constexpr (Comparison == EComparison::Greater)
+		{
+			return PakPluginStatus > Status;
+		}
+		else if constexpr (Comparison == EComparison::LessOrEqual)
+		{
+			return PakPluginStatus <= Status;
+		}
+		else if constexpr (Comparison == EComparison::Less)
+		{
+			return PakPluginStatus < Status;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
 	/**
 	 * Enumerate all the PakPlugins registered with the subsystem with their Status matching the Status and Comparison.
-	 * @param Callback Callback to be called on each PakPlugin. It is guaranteed that the PakPlugin is a valid UObject. Return true to break out of the loop.
+	 * The PakPlugins are read from buckets kept up to date for each Status, so only the matching PakPlugins are visited, without copying them.
+	 * @param Callback Callback to be called on each PakPlugin. It is guaranteed that the PakPlugin is a valid UObject.
+	 * The Callback is called while the buckets are locked, so it must not change the Status of a PakPlugin (mount, unmount, activate...) nor enumerate them again.
+	 * Use GetPakPluginsWithStatus to get a copy of the PakPlugins instead.
 	 */
 	template <EComparison Comparison>
 	void EnumeratePakPluginsWithStatus(EGFPakLoaderStatus Status, TFunctionRef<EForEachResult(UGFPakPlugin* PakPlugin)> Callback)
 	{
-		auto Predicate =[Status](const UGFPakPlugin* PakPlugin)
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_ReadOnly);
+		for (int32 StatusIndex = 0; StatusIndex < NumPakLoaderStatuses; ++StatusIndex)
 		{
-			if constexpr (Comparison == EComparison::Equal)
-			{
-				return PakPlugin->GetStatus() == Status;
-			}
-			else if constexpr (Comparison == EComparison::NotEqual)
-			{
-				return PakPlugin->GetStatus() != Status;
-			}
-			else if constexpr (Comparison == EComparison::GreaterOrEqual)
+			if (!CompareStatus<Comparison>(static_cast<EGFPakLoaderStatus>(StatusIndex), Status))
 			{
-				return PakPlugin->GetStatus() >= Status;
+				continue;
 			}
-			else if constexpr (Comparison == EComparison::Greater)
+			for (UGFPakPlugin* PakPlugin : PakPluginsByStatus[StatusIndex])
 			{
-				return PakPlugin->GetStatus() > Status;
-			}
-			else if constexpr (Comparison == EComparison::LessOrEqual)
-			{
-				return PakPlugin->GetStatus() <= Status;
-			}
-			else if constexpr (Comparison == EComparison::Less)
-			{
-				return PakPlugin->GetStatus() < Status;
-			}
-			else
-			{
-				return false;
+				if (IsValid(PakPlugin))
+				{
+					if (Callback(PakPlugin) == EForEachResult::Break)
+					{
+						return;
+					}
+				}
 			}
-		};
-		
-		EnumeratePakPlugins(Predicate, Callback);
+		}
 	}
 	
+	/** Returns a copy of the PakPlugins with their Status matching the Status and Comparison, which can then change their Status. See EnumeratePakPluginsWithStatus */
 	template <EComparison Comparison>
 	TArray<UGFPakPlugin*> GetPakPluginsWithStatus(EGFPakLoaderStatus Status)
 	{
 		TArray<UGFPakPlugin*> Plugins;
-		EnumeratePakPluginsWithStatus<Comparison>(Status, [&Plugins](UGFPakPlugin* PakPlugin)
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_ReadOnly);
+		for (int32 StatusIndex = 0; StatusIndex < NumPakLoaderStatuses; ++StatusIndex)
 		{
-			Plugins.Add(PakPlugin);
-			return EForEachResult::Continue;
-		});
+			if (CompareStatus<Comparison>(static_cast<EGFPakLoaderStatus>(StatusIndex), Status))
+			{
+				Plugins.Append(PakPluginsByStatus[StatusIndex]);
+			}
+		}
 		return Plugins;
 	}
+	/** Returns the number of PakPlugins with their Status matching the Status and Comparison, without going through the PakPlugins */
+	template <EComparison Comparison>
+	int32 GetNumPakPluginsWithStatus(EGFPakLoaderStatus Status) const
+	{
+		int32 NumPlugins = 0;
+		FRWScopeLock Lock(PakPluginsByStatusLock, SLT_ReadOnly);
+		for (int32 StatusIndex = 0; StatusIndex < NumPakLoaderStatuses; ++StatusIndex)
+		{
+			if (CompareStatus<Comparison>(static_cast<EGFPakLoaderStatus>(StatusIndex), Status))
+			{
+				NumPlugins += PakPluginsByStatus[StatusIndex].Num();
+			}
+		}
+		return NumPlugins;
+	}
+	/**
+	 * Returns the PakPlugin providing the given root Mount Point name, ex: 'DLCTestProject', or a path inside it, ex: '/DLCTestProject/Maps', with a single lookup.
+	 * The name is matched, in order, against the Mount Point the PakPlugin is about to mount (Editor only), the name of the PakPlugin, and the registered Mount Points of the PakPlugin.
+	 * @param OutReason Optional. Returns which of the above matched, for debugging
+	 */
+	UGFPakPlugin* FindPakPluginByMountPointName(FStringView MountPointName, const TCHAR** OutReason = nullptr) const;
+	/**
+	 * Mounts the PakPlugin registered on demand that provides the given package, ex: '/my-plugin-name/Maps/MyMap'. See UGFPakLoaderSettings::bMountPakPluginsOnDemand
+	 * The mounting is only done on the Game Thread, and does nothing if no PakPlugin is registered on demand.
+	 * @return Returns the PakPlugin that was mounted, otherwise null
+	 */
+	UGFPakPlugin* MountOnDemandPakPluginProvidingPackage(FStringView PackageName);
+	/**
+	 * Unmounts the least recently used PakPlugins while UGFPakLoaderSettings::MaxMountedPakPlugins or UGFPakLoaderSettings::PakPluginsMemoryBudget is exceeded.
+	 * Only the PakPlugins idle for UGFPakLoaderSettings::PakPluginEvictionMinIdleSeconds whose loaded content is not in use are unmounted: they must not provide a level
+	 * or an actor class of a loaded world, and their loaded packages must not be rooted or referenced from outside of the PakPlugin. See UGFPakPlugin::IsContentInUse
+	 * Called every second by the subsystem. The GameFeatures of the activated PakPlugins are deactivated first, so they finish unmounting later on.
+	 * The referencers of all the PakPlugins that could be evicted are found in a single pass, and their loaded packages sizes are only computed when PakPluginsMemoryBudget is set.
+	 * Both are only computed again for a PakPlugin once its content was accessed or a garbage collection ran, so a PakPlugin found in use is not checked every second.
+	 * @return Returns the number of PakPlugins being unmounted
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	int32 EvictLeastRecentlyUsedPakPlugins();
 	
 	TSharedPtr<FPluginMountPoint> AddOrCreateMountPointFromContentPath(const FString& InContentPath);
 
@@ -257,6 +441,42 @@ public:
 	 * @return Returns the PakPlugin in which the file should reside, otherwise null
 	 */
 	UGFPakPlugin* FindMountedPakContainingFile(const TCHAR* OriginalFilename, FString* PakAdjustedFilename = nullptr);
+	/**
+	 * Returns the Pak Plugin currently providing the given asset when it is provided by multiple Pak Plugins or overrides a Base Game asset.
+	 * @param AssetPath The path of the asset
+	 * @param bOutIsOverridden Set to true if the asset is provided by multiple sources
+	 * @return Returns the Pak Plugin with the highest priority providing the asset, or null if the asset is not overridden or if the Base Game asset is used
+	 */
+	UGFPakPlugin* GetWinningPakPlugin(const FSoftObjectPath& AssetPath, bool& bOutIsOverridden);
+
+	/**
+	 * Enumerate the assets of the given class provided by all the mounted Pak Plugins and the ones registered on demand, without having to query each Pak Plugin.
+	 * An asset provided by multiple Pak Plugins is enumerated once per Pak Plugin.
+	 * @param Callback Callback to be called on each asset. The index is locked during the enumeration, so the callback should not mount or unmount Pak Plugins.
+	 */
+	void EnumeratePakAssetsOfClass(const FTopLevelAssetPath& ClassPathName, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const;
+	/**
+	 * Enumerate the assets located in the given package path provided by all the mounted Pak Plugins and the ones registered on demand, ex: '/my-plugin-name/Maps'.
+	 * @param bRecursive If true, the assets located in the sub paths are enumerated too
+	 * @param Callback Callback to be called on each asset. The index is locked during the enumeration, so the callback should not mount or unmount Pak Plugins.
+	 */
+	void EnumeratePakAssetsInPath(FName PackagePath, bool bRecursive, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const;
+	/**
+	 * Enumerate the assets having the given value for the given Asset Registry tag provided by all the mounted Pak Plugins and the ones registered on demand.
+	 * Only the tags listed in UGFPakLoaderSettings::IndexedAssetTags can be queried.
+	 * @param Callback Callback to be called on each asset. The index is locked during the enumeration, so the callback should not mount or unmount Pak Plugins.
+	 */
+	void EnumeratePakAssetsWithTagValue(FName Tag, const FString& Value, TFunctionRef<EForEachResult(const FGFPakPluginAsset& PakAsset)> Callback) const;
+	
+	/** Returns the assets of the given class provided by all the mounted Pak Plugins. See EnumeratePakAssetsOfClass */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	void GetPakAssetsOfClass(const UClass* Class, TArray<FGFPakPluginAsset>& OutPakAssets) const;
+	/** Returns the assets located in the given package path provided by all the mounted Pak Plugins. See EnumeratePakAssetsInPath */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	void GetPakAssetsInPath(const FString& PackagePath, bool bRecursive, TArray<FGFPakPluginAsset>& OutPakAssets) const;
+	/** Returns the assets having the given value for the given Asset Registry tag provided by all the mounted Pak Plugins. See EnumeratePakAssetsWithTagValue */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader Subsystem")
+	void GetPakAssetsWithTagValue(FName Tag, const FString& Value, TArray<FGFPakPluginAsset>& OutPakAssets) const;
 private:
 	FGFPakLoaderPlatformFile* GFPakPlatformFile = nullptr;
 	
@@ -273,6 +493,59 @@ private:
 	mutable FRWLock GameFeaturesPakPluginsLock;
 	UPROPERTY(Transient)
 	TArray<UGFPakPlugin*> GameFeaturesPakPlugins;
+	/** The GameFeaturesPakPlugins by their normalized Pak Plugin directory, to not have to compare the paths of every Pak Plugin in GetOrAddPakPlugin */
+	UPROPERTY(Transient)
+	TMap<FString, UGFPakPlugin*> GameFeaturesPakPluginsByDirectory;
+	/** Returns the Pak Plugin registered for the given normalized directory. The GameFeaturesPakPluginsLock needs to be locked */
+	UGFPakPlugin* FindPakPluginByDirectory(const FString& NormalizedPakPluginDirectory) const;
+
+	static constexpr int32 NumPakLoaderStatuses = static_cast<int32>(EGFPakLoaderStatus::GameFeatureActivated) + 1;
+	/** Separate from the GameFeaturesPakPluginsLock as the Status of the PakPlugins change while the GameFeaturesPakPlugins are enumerated */
+	mutable FRWLock PakPluginsByStatusLock;
+	/**
+	 * The GameFeaturesPakPlugins bucketed by their current Status, in the order they entered it. Updated by UGFPakPlugin::SetStatus, which also sees
+	 * the temporary Status changes that are not broadcasted, like the PakPlugin being temporary Mounted while mounting.
+	 */
+	TStaticArray<TArray<UGFPakPlugin*>, NumPakLoaderStatuses> PakPluginsByStatus;
+	/** The PakPlugins with a Status >= `Mounted`, in the order they were mounted. Also guarded by the PakPluginsByStatusLock. See SaveSessionSnapshot */
+	TArray<UGFPakPlugin*> MountedPakPluginsInOrder;
+	/**
+	 * The PakPlugins with a Status >= `Mounted` sorted by descending priority, the ones mounted first going first for equal priorities. Also guarded by the PakPluginsByStatusLock.
+	 * Lets FindMountedPakContainingFile stop at the first PakPlugin containing the file. The priority of a PakPlugin cannot change while it is mounted.
+	 */
+	TArray<UGFPakPlugin*> MountedPakPluginsByPriority;
+	/** Moves the PakPlugin to the bucket of its new Status if it is registered with the subsystem */
+	void OnPakPluginStatusSet(UGFPakPlugin* PakPlugin, EGFPakLoaderStatus OldStatus, EGFPakLoaderStatus NewStatus);
+
+	/** Separate from the other locks as the Mount Point names are looked up from IPluginManager::RegisterMountPoint and the Content Browser callbacks */
+	mutable FRWLock MountPointNamesLock;
+	/**
+	 * The PakPlugins with a Status >= `Unmounted` by their PluginName, which is also the name of their plugin Mount Point.
+	 * Only one PakPlugin is indexed per name, the first one, and another PakPlugin with the same name takes its place when it is removed. See RemovePakPluginName
+	 */
+	TMap<FName, UGFPakPlugin*> PakPluginsByName;
+	/** Removes the PakPlugin from PakPluginsByName, and indexes another PakPlugin with a Status >= `Unmounted` and the same name instead if there is one */
+	void RemovePakPluginName(UGFPakPlugin* PakPlugin);
+	/** The Mount Points added by the mounted PakPlugins by their root Mount Point name. A PakPlugin only matches if the Mount Point is still registered */
+	TMultiMap<FName, TPair<UGFPakPlugin*, TWeakPtr<FPluginMountPoint>>> PakPluginsByMountPointName;
+	/** Adds the PakPluginMountPoints of the PakPlugin to PakPluginsByMountPointName. Called once the PakPlugin created its Mount Points */
+	void AddPakPluginMountPointNames(UGFPakPlugin* PakPlugin);
+	/** Removes all the entries of the PakPlugin from PakPluginsByMountPointName */
+	void RemovePakPluginMountPointNames(UGFPakPlugin* PakPlugin);
+#if WITH_EDITOR
+	/** The Mount Points the PakPlugins are about to mount by their root Mount Point name. See UGFPakPlugin::GetMountPointAboutToBeMounted */
+	TMap<FName, UGFPakPlugin*> PakPluginsByMountPointAboutToBeMounted;
+	/** Replaces the Mount Point the PakPlugin is about to mount. An empty RootPath only removes the previous one */
+	void SetPakPluginMountPointAboutToBeMounted(UGFPakPlugin* PakPlugin, const FString& RootPath);
+#endif
+	/** Returns the FName of the root Mount Point name of the path, or NAME_None if no such FName exists, in which case no PakPlugin can be using it */
+	static FName FindMountPointName(FStringView Path);
+	/** The PakPlugins registered without mounting their pak by the root names of their Mount Points. See UGFPakLoaderSettings::bMountPakPluginsOnDemand */
+	TMap<FName, UGFPakPlugin*> OnDemandPakPluginsByMountPointName;
+	void AddOnDemandPakPlugin(UGFPakPlugin* PakPlugin, const TArray<TSharedPtr<FPluginMountPoint>>& PakPluginMountPoints);
+	void RemoveOnDemandPakPlugin(UGFPakPlugin* PakPlugin);
+	/** Bound to FCoreDelegates::OnSyncLoadPackage and OnAsyncLoadPackage to mount the PakPlugins registered on demand before their packages are loaded */
+	void OnLoadPackage(const FString& PackageName);
 
 	FGFPakLoaderSubsystemEvent OnSubsystemReadyDelegate;
 	FGFPakLoaderSubsystemEvent OnStartupPaksAddedDelegate;
@@ -282,6 +555,7 @@ private:
 	FOnStatusChanged OnPakPluginStatusChangedDelegate;
 	FPakPluginEvent OnPakPluginAddedDelegate;
 	FPakPluginEvent OnPakPluginRemovedDelegate;
+	FGameFeatureActivationsEvent OnScheduledGameFeatureActivationsCompletedDelegate;
 
 	/**
 	 * A Map from the Content Path on disk to the matching MountPoint.
@@ -309,22 +583,219 @@ private:
 	TSet<FString> IgnoredPluginPaths;
 	TSet<FString> InvalidDirectories;
 
+	FCriticalSection PakPluginDirectoriesInfoMutex;
+	/** The layout of the existing Pak Plugin directories already validated, to not list them again on every AddPakPluginFolder if they did not change. Removed with their Pak Plugin or folder */
+	TMap<FString, FGFPakPluginDirectoryInfo> PakPluginDirectoriesInfo;
+	/** Returns the cached FGFPakPluginDirectoryInfo of the given directory if it is still up to date, otherwise gathers it again */
+	FGFPakPluginDirectoryInfo GetPakPluginDirectoryInfo(const FString& PakPluginDirectory);
+
+	/** The data derived from a pak when it was last mounted, kept after unmounting to remount it cheaply. See UGFPakLoaderSettings::RemountCacheSize */
+	struct FPakRemountData
+	{
+		// The identity of the pak, the data are only reused if the pak file did not change
+		FString PakFilePath;
+		int64 PakFileSize = INDEX_NONE;
+		FDateTime PakFileTimestamp;
+		
+		FString AssetRegistryPath;
+		TArray<FString> ContentFolders;
+		TMap<FName, TSharedPtr<const FGFPakFilenameMap>> PakFilenamesMap;
+		FAssetRegistryState AssetRegistryState;
+	};
+	FCriticalSection RemountCacheMutex;
+	/** Ordered from the least to the most recently unmounted pak */
+	TArray<FPakRemountData> RemountCache;
+
+	/** A Pak Plugin folder changed, waiting for UGFPakLoaderSettings::PakLoadPathWatchDebounceSeconds without any change before being processed */
+	struct FPendingPakPluginDirectory
+	{
+		double LastChangeTime = 0.0;
+		// The total size and the latest modification time of the pak files, to only process the folder once the pak files are fully written
+		int64 PakFilesSize = 0;
+		FDateTime PakFilesTimestamp;
+	};
+	/** The absolute and normalized PakLoadPath being watched, empty if not watching. See UGFPakLoaderSettings::bWatchPakLoadPath */
+	FString WatchedPakLoadPath;
+	TMap<FString, FPendingPakPluginDirectory> PendingPakPluginDirectories;
+	FTSTicker::FDelegateHandle PakLoadPathWatcherTickHandle;
+#if WITH_EDITOR
+	FDelegateHandle DirectoryWatcherHandle;
+	void OnWatchedDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+#else
+	// Without the DirectoryWatcher, we poll the timestamp of the PakLoadPath to find the added and removed folders, and check the cached FGFPakPluginDirectoryInfo of the known folders less often
+	FDateTime WatchedPakLoadPathTimestamp;
+	/** The known folders, with their layout as last processed by the watcher. Until a folder is processed, the layout cached when validating it is used instead */
+	TMap<FString, TOptional<FGFPakPluginDirectoryInfo>> WatchedPakPluginDirectories;
+	double LastPakLoadPathPollTime = 0.0;
+	double LastPakPluginDirectoriesCheckTime = 0.0;
+	/** Polled every UGFPakLoaderSettings::PakLoadPathWatchDebounceSeconds */
+	void PollWatchedPakLoadPath();
+	/** Queues the known folders whose layout changed, every UGFPakLoaderSettings::PakLoadPathWatchFolderCheckSeconds */
+	void CheckWatchedPakPluginDirectories();
+#endif
+	void StartWatchingPakLoadPath();
+	void StopWatchingPakLoadPath();
+	/** Queues the Pak Plugin folder containing the given path, and restarts its debounce */
+	void QueueWatchedPath(const FString& Path);
+	bool TickPakLoadPathWatcher(float DeltaTime);
+	/** Adds, reloads or removes the Pak Plugin of a watched folder that changed */
+	void ProcessWatchedPakPluginDirectory(const FString& PakPluginDirectory);
+	/** Returns true if the folder needs to be ignored as per UGFPakLoaderSettings::IgnorePakWithPrefix, and logs it once */
+	bool IsIgnoredPakPluginFolder(const FString& PakPluginDirectory);
+	/**
+	 * Returns the total size and the latest modification time of the pak files of the Pak Plugin folder.
+	 * The pak files are found through GetPakPluginDirectoryInfo, so the folder is only listed again if its layout changed
+	 */
+	void GetPakFilesStat(const FString& PakPluginDirectory, int64& OutSize, FDateTime& OutTimestamp);
+
+	/** A GameFeature activation waiting for the PakPlugins it depends on. See ScheduleGameFeatureActivation */
+	struct FScheduledGameFeatureActivation
+	{
+		TWeakObjectPtr<UGFPakPlugin> PakPlugin;
+		FName PluginName;
+		// The names of the enabled plugins referenced by the FPluginDescriptor of the PakPlugin
+		TArray<FName> Dependencies;
+		FOperationCompleted CompleteDelegate;
+	};
+	/** In the order they were scheduled */
+	TArray<FScheduledGameFeatureActivation> PendingGameFeatureActivations;
+	/** The names of the scheduled PakPlugins currently activating their GameFeature */
+	TArray<FName> InFlightGameFeatureActivations;
+	TArray<TWeakObjectPtr<UGFPakPlugin>> FailedGameFeatureActivations;
+	bool bHasScheduledGameFeatureActivations = false;
+	FTSTicker::FDelegateHandle GameFeatureActivationsTickHandle;
+	/** Starts the next GameFeature activations on the next tick, so all the PakPlugins scheduled in the same frame are ordered together */
+	void RequestGameFeatureActivationsUpdate();
+	bool UpdateScheduledGameFeatureActivations(float DeltaTime);
+	/** Completes the pending GameFeature activations of the PakPlugin with a failure, so a PakPlugin unmounted before they start is not mounted again by ActivateGameFeature */
+	void CancelScheduledGameFeatureActivations(UGFPakPlugin* PakPlugin);
+	
+	FTSTicker::FDelegateHandle PakPluginsEvictionTickHandle;
+	bool TickPakPluginsEviction(float DeltaTime);
+	/** Unmounts the PakPlugin after deactivating its GameFeature if needed, and registers it on demand again if UGFPakLoaderSettings::bMountPakPluginsOnDemand is true */
+	static void EvictPakPlugin(UGFPakPlugin* PakPlugin);
+	/**
+	 * Returns the names of the packages of the levels of the loaded worlds and of the classes of their actors, which keep the PakPlugins providing them mounted.
+	 * The result is cached until a world or a level is added or removed. The actors spawned since are covered by UGFPakPlugin::IsContentInUse
+	 */
+	const TSet<FName>& GetPackagesReferencedByLoadedWorlds();
+	TSet<FName> PackagesReferencedByLoadedWorlds;
+	bool bPackagesReferencedByLoadedWorldsDirty = true;
+	/**
+	 * What the eviction last found about the loaded packages of a PakPlugin. They are only loaded by reading its pak, which updates its LastAccessTime, and only unloaded
+	 * by a garbage collection, so they are known to be the same as long as both are unchanged. See EvictLeastRecentlyUsedPakPlugins
+	 */
+	struct FPakPluginEvictionState
+	{
+		double LastAccessTime = 0.0;
+		uint32 NumGarbageCollections = 0;
+		// Not computed yet when negative
+		int64 LoadedPackagesSize = -1;
+		TOptional<bool> IsContentInUse;
+		bool IsUpToDate(const UGFPakPlugin* PakPlugin, const uint32 CurrentNumGarbageCollections) const
+		{
+			return LastAccessTime == PakPlugin->GetLastAccessTime() && NumGarbageCollections == CurrentNumGarbageCollections;
+		}
+	};
+	TMap<const UGFPakPlugin*, FPakPluginEvictionState> PakPluginsEvictionStates;
+	/** Returns the eviction state of the PakPlugin, reset if its loaded packages might have changed since */
+	FPakPluginEvictionState& GetPakPluginEvictionState(const UGFPakPlugin* PakPlugin);
+	/** Incremented after each garbage collection, as it might unload the packages of the PakPlugins */
+	uint32 NumGarbageCollections = 0;
+	
+	/** A mount waiting in the queue of its priority. See ScheduleMount */
+	struct FScheduledMount
+	{
+		TWeakObjectPtr<UGFPakPlugin> PakPlugin;
+		FOperationCompleted CompleteDelegate;
+	};
+	/** The scheduled mounts by EGFPakMountPriority, in the order they were scheduled */
+	TStaticArray<TArray<FScheduledMount>, 3> ScheduledMounts;
+	FTSTicker::FDelegateHandle ScheduledMountsTickHandle;
+	/** The bytes the background mounts are allowed to read, refilled at UGFPakLoaderSettings::BackgroundMountBandwidth. Negative while paying back the last background mount */
+	double BackgroundMountTokens = 0.0;
+	double LastBackgroundMountTokensRefillTime = 0.0;
+	/** The time and the pak size of the mounts completed within MountThroughputWindowSeconds, to report the throughput */
+	TArray<TPair<double, int64>> RecentMounts;
+	static constexpr double MountThroughputWindowSeconds = 10.0;
+	int32 NumCompletedMounts = 0;
+	int64 MountedBytes = 0;
+	bool TickScheduledMounts(float DeltaTime);
+	/** Mounts the PakPlugin and returns the bytes read by the mount if it was mounted by this call, otherwise 0. See UGFPakPlugin::GetMountReadBytes */
+	int64 RunScheduledMount(FScheduledMount&& ScheduledMount);
+	
+	/** Runs the Operation on each unique PakPlugin and calls the CompleteDelegate once all of them completed. See ActivateGameFeatures */
+	static void RunBatchOperation(const TArray<UGFPakPlugin*>& PakPlugins, const FBatchOperationCompleted& CompleteDelegate, TFunctionRef<void(UGFPakPlugin*, const FOperationCompleted&)> Operation);
+	/** Keeps the data of a pak that was just unmounted, evicting the least recently unmounted ones above UGFPakLoaderSettings::RemountCacheSize */
+	void AddPakRemountData(FPakRemountData&& RemountData);
+	/** Removes and returns the data of the given pak if they are cached and the pak file did not change since */
+	TOptional<FPakRemountData> TakePakRemountData(const FString& PakFilePath);
+
 	
 	FCriticalSection AssetOwnerMutex;
-	struct FAssetOwner
+	/** An asset provided by multiple sources: the Base Game and/or multiple Pak Plugins */
+	struct FAssetOverride
 	{
-		bool bIsBaseGameAsset = false;
-		FAssetData BaseGameAssetData;
-		TArray<UGFPakPlugin*> PluginOwners; // Not yet really needed, but will be useful once we tackle which Pak Plugin has priority
+		struct FOwner
+		{
+			UGFPakPlugin* Plugin = nullptr; // null for the Base Game
+			int32 Priority = MIN_int32;
+			int32 AssetDataIndex = INDEX_NONE; // Index in OverriddenAssetsData
+		};
+		// Sorted by descending priority, so the first owner is the one currently registered in the Asset Registry
+		TArray<FOwner, TInlineAllocator<2>> Owners;
 	};
-	// Keep track of assets added by the DLC Paks and previously existing assets
-	TMap<FSoftObjectPath, FAssetOwner> AssetOwners;
+	/**
+	 * Keep track of assets added by the DLC Paks that override previously existing assets. Assets not overriding anything are not recorded,
+	 * and an entry is removed as soon as only one owner remains.
+	 */
+	TMap<FSoftObjectPath, FAssetOverride> AssetOverrides;
+	/** The Asset Data of each owner of the AssetOverrides, needed to restore the right one in the Asset Registry when the winning owner is unmounted */
+	TSparseArray<FAssetData> OverriddenAssetsData;
+	/** The paths of the AssetOverrides owned by each Pak Plugin, so mounting or unmounting a Pak Plugin only goes through its own overrides */
+	TMap<UGFPakPlugin*, TSet<FSoftObjectPath>> AssetOverridesByPlugin;
 	
 	friend UGFPakPlugin;
 	/** Function to ensure the Pak assets added to the asset registry are recorded as we might be "overriding" some existing ones */
 	void OnPreAddPluginAssetRegistry(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin);
+	/** Function to restore in the asset registry the overridden assets that have a higher priority than the ones just added by the Pak Plugin */
+	void OnPostAddPluginAssetRegistry(UGFPakPlugin* Plugin);
 	/** Function to remove the Pak assets from the asset registry while keeping the existing ones */
 	void OnPreRemovePluginAssetRegistry(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin, TSet<FName>& OutPackageNamesToRemove);
+	/** Returns the Asset Data recorded for the given Pak Plugin if it provides an overridden asset. See UGFPakPlugin::GetPluginAssetData */
+	bool FindOverriddenAssetData(const UGFPakPlugin* Plugin, const FSoftObjectPath& AssetPath, FAssetData& OutAssetData);
+
+	mutable FRWLock PakAssetsIndexLock;
+	/**
+	 * Index of the assets of all the mounted Pak Plugins and of the ones registered on demand, updated when a Pak Plugin Asset Registry is added or removed,
+	 * so the queries across Pak Plugins only scale with the number of results and not with the number of Pak Plugins.
+	 */
+	struct FPakAssetsIndex
+	{
+		TMap<FTopLevelAssetPath, TArray<FGFPakPluginAsset>> AssetsByClass;
+		TMap<FName, TArray<FGFPakPluginAsset>> AssetsByPackagePath;
+		/** The direct sub paths of each package path, including the parent paths without any asset, to resolve the recursive path queries */
+		TMap<FName, TSet<FName>> SubPackagePaths;
+		/** Tag -> Value -> Assets, only for the tags listed in UGFPakLoaderSettings::IndexedAssetTags */
+		TMap<FName, TMap<FString, TArray<FGFPakPluginAsset>>> AssetsByTagValue;
+		
+		struct FPluginKeys
+		{
+			TSet<FTopLevelAssetPath> Classes;
+			TSet<FName> PackagePaths;
+			TSet<TPair<FName, FString>> TagValues;
+		};
+		/** The keys under which each Pak Plugin has assets, so a Pak Plugin can be removed without going through the whole index */
+		TMap<UGFPakPlugin*, FPluginKeys> PluginKeys;
+		
+		void AddPackagePath(FName PackagePath);
+		void RemovePackagePathIfEmpty(FName PackagePath);
+	};
+	FPakAssetsIndex PakAssetsIndex;
+	/** Function to add the Pak assets to the PakAssetsIndex */
+	void AddPluginToAssetsIndex(const FAssetRegistryState& PluginAssetRegistry, UGFPakPlugin* Plugin);
+	/** Function to remove the Pak assets from the PakAssetsIndex */
+	void RemovePluginFromAssetsIndex(UGFPakPlugin* Plugin);
 
 public: // Debug Functions
 	/** Print in the log the value of the Platform Paths, as they might differ on different configs and platforms */
@@ -336,6 +807,8 @@ public: // Debug Functions
 	void OnContentPathDismounted(const FString& AssetPath, const FString& ContentPath);
 	
 	void OnEnsureWorldIsLoadedInMemoryBeforeLoadingMapChanged();
+	/** Starts or stops watching the PakLoadPath as per UGFPakLoaderSettings::bWatchPakLoadPath */
+	void OnWatchPakLoadPathChanged();
 
 	/** Helper function to return a string describing the PackageFlags */
 	static FString PackageFlagsToString(uint32 PackageFlags);
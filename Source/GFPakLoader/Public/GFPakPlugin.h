@@ -13,6 +13,8 @@
 
 
 class UGFPakLoaderSubsystem;
+enum class EBuiltInAutoState : uint8;
+struct FStreamableHandle;
 
 UENUM(BlueprintType)
 enum class EGFPakLoaderStatus : uint8
@@ -57,6 +59,28 @@ struct FGFPakFilenameMap : TSharedFromThis<FGFPakFilenameMap>
 	static FGFPakFilenameMap FromFilenameAndMountPoints(const FString& OriginalMountPoint, const FString& AdjustedMountPoint, const FString& OriginalFilename);
 };
 
+/**
+ * The facts needed to validate a Pak Plugin directory, gathered without searching recursively for the pak. See UGFPakPlugin for the expected layout.
+ * FromDirectory stats and lists the plugin directory, stats and lists 'Content/Paks/', and lists each of its platform directories.
+ * They are cached by the UGFPakLoaderSubsystem and reused as long as the modification time of the listed directories did not change, which IsUpToDate checks with one stat per directory.
+ */
+struct FGFPakPluginDirectoryInfo
+{
+	bool bDirectoryExists = false;
+	bool bHasUPlugin = false;
+	bool bHasPaksDirectory = false;
+	// The pak files found in 'Content/Paks/' and 'Content/Paks/<platform>/'
+	TArray<FString> PakFiles;
+	// The utoc files found next to the pak files, as IO Store is not supported yet
+	TArray<FString> UtocFiles;
+	// The listed directories and their modification time, FDateTime::MinValue() if they did not exist
+	TArray<TPair<FString, FDateTime>> DirectoryTimestamps;
+
+	static FGFPakPluginDirectoryInfo FromDirectory(const FString& PakPluginDirectory);
+	/** Returns true if none of the listed directories changed since this info was gathered */
+	bool IsUpToDate() const;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnStatusChanged, class UGFPakPlugin*, PakPlugin, EGFPakLoaderStatus, OldStatus, EGFPakLoaderStatus, NewStatus);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPluginEvent, class UGFPakPlugin*, PakPlugin);
 
@@ -118,6 +142,30 @@ public:
 	 * If the plugin was already Deactivated, the Status will not change.
 	 */
 	void DeactivateGameFeature(const FOperationCompleted& CompleteDelegate);
+	/**
+	 * Tells the Pak Plugin its content is being used. If the Pak Plugin is waiting for its first access to activate its GameFeature,
+	 * the activation is scheduled with UGFPakLoaderSubsystem::ScheduleGameFeatureActivation. See UGFPakLoaderSettings::bActivateGameFeaturesOnFirstAccess
+	 * Can be called from any thread.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader")
+	void NotifyContentAccessed();
+	/** Returns true if the GameFeature of this Pak Plugin will be activated the first time its content is accessed. See NotifyContentAccessed */
+	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader")
+	bool IsWaitingForFirstAccess() const { return bWaitingForFirstAccess; }
+	/**
+	 * Returns true if the assets of this `Unmounted` Pak Plugin were added to the Asset Registry from its cache without mounting its pak,
+	 * which will be mounted the first time one of its packages is loaded. See UGFPakLoaderSettings::bMountPakPluginsOnDemand
+	 */
+	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader")
+	bool IsRegisteredOnDemand() const { return OnDemandRegistration.IsSet(); }
+	/**
+	 * Registers this `Unmounted` Pak Plugin from its cache without mounting its pak, which will be mounted when one of its packages is loaded. See UGFPakLoaderSettings::bMountPakPluginsOnDemand
+	 * @return Returns true if the Pak Plugin is registered on demand, false if it is not `Unmounted` or does not have an up-to-date cache.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader")
+	bool RegisterOnDemand();
+	/** Returns the FPlatformTime::Seconds at which the content of this Pak Plugin was last accessed, or at which it was mounted */
+	double GetLastAccessTime() const { return LastAccessTime.load(std::memory_order_relaxed); }
 
 	/**
 	 * Unmounts the Pak Plugin to the engine. Its assets cannot be used anymore.
@@ -168,23 +216,27 @@ public:
 	}
 
 	/**
-	 * Return the array of Assets of the given class cached by the PluginAssetRegistry.
+	 * Return the array of Assets of the given class, cached by this Pak Plugin the first time a class is requested. The cache is cleared when the Status changes.
 	 * Only Valid if Status is >= `Mounted`
+	 * If UGFPakLoaderSettings::bKeepPluginAssetRegistryInMemory is false, the assets are retrieved from the global Asset Registry.
 	 * If you want to filter the assets, use GetPluginAssetsOfClass(const UClass*, TArray<FAssetData>&, bool) instead, or directly PluginAssetRegistry->GetAssets
+	 * @param ClassPathName The class of the assets to find
+	 * @param bIncludeCookGeneratedAssets If set to false, will exclude the assets generated by the cooker (having the flag PKG_CookGenerated)
 	 */
-	const TArray<const FAssetData*>& GetPluginAssetsOfClass(const FTopLevelAssetPath& ClassPathName);
-	const TArray<const FAssetData*>& GetPluginAssetsOfClass(const UClass* Class)
+	const TArray<const FAssetData*>& GetPluginAssetsOfClass(const FTopLevelAssetPath& ClassPathName, bool bIncludeCookGeneratedAssets = true);
+	const TArray<const FAssetData*>& GetPluginAssetsOfClass(const UClass* Class, bool bIncludeCookGeneratedAssets = true)
 	{
-		return IsValid(Class) ? GetPluginAssetsOfClass(Class->GetClassPathName()) : EmptyAssetsData;
+		return IsValid(Class) ? GetPluginAssetsOfClass(Class->GetClassPathName(), bIncludeCookGeneratedAssets) : EmptyAssetsData;
 	}
 	/**
-	 * Return the array of UWorld Assets cached by the PluginAssetRegistry.
+	 * Return the array of UWorld Assets, cached by this Pak Plugin the first time it is requested. The cache is cleared when the Status changes.
 	 * Only Valid if Status is >= `Mounted`
 	 * If you want to filter the assets, use GetPluginAssetsOfClass(const UClass*, TArray<FAssetData>&, bool) instead, or directly PluginAssetRegistry->GetAssets
+	 * @param bIncludeCookGeneratedAssets If set to false, will exclude the assets generated by the cooker (having the flag PKG_CookGenerated)
 	 */
-	const TArray<const FAssetData*>& GetPluginWorldAssets()
+	const TArray<const FAssetData*>& GetPluginWorldAssets(bool bIncludeCookGeneratedAssets = true)
 	{
-		return GetPluginAssetsOfClass(UWorld::StaticClass()->GetClassPathName());
+		return GetPluginAssetsOfClass(UWorld::StaticClass()->GetClassPathName(), bIncludeCookGeneratedAssets);
 	}
 
 	/** Returns the path to the Pak Plugin Directory this struct points to, for example 'C:/Pak/my-plugin-name/' */
@@ -213,6 +265,27 @@ public:
 		return false;
 	}
 
+	/**
+	 * Returns the priority of this Pak Plugin. When multiple Pak Plugins contain the same asset, the one with the highest priority is used.
+	 * When the priorities are equal, the Pak Plugin mounted first is used. Base Game assets always have a lower priority than Pak Plugin assets.
+	 */
+	UFUNCTION(BlueprintPure, Category="GameFeatures Pak Loader")
+	int32 GetPakPriority() const { return PakPriority; }
+	/**
+	 * Sets the priority of this Pak Plugin. See GetPakPriority.
+	 * @return Returns true if we were able to change the priority of the plugin which is only possible when the plugin is not Mounted.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GameFeatures Pak Loader")
+	bool SetPakPriority(const int32 InPakPriority)
+	{
+		if (Status < EGFPakLoaderStatus::Mounted)
+		{
+			PakPriority = InPakPriority;
+			return true;
+		}
+		return false;
+	}
+
 	/**
 	 * Returns the name of the folder of this Pak Plugin.
 	 * If GetPakPluginDirectory returns 'C:/Pak/my-plugin-name/', this function would return `my-plugin-name`
@@ -255,6 +328,11 @@ public:
 	 * Only Valid if Status is >= `Unmounted`
 	 */
 	const FString& GetPakFilePath() const { return PakFilePath; }
+	/**
+	 * Returns an estimate of the bytes read from the disk by mounting this Pak Plugin: the index of its pak, and its AssetRegistry.bin if it was read from the pak.
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	int64 GetMountReadBytes() const { return Status >= EGFPakLoaderStatus::Mounted ? MountReadBytes : 0; }
 	/**
 	 * Returns true if this PakPlugin has a .uplugin. PakPlugin are not required to have a .uplugin if UGFPakLoaderSettings::bRequireUPluginPaks is false
 	 * Only Valid if Status is >= `Unmounted`
@@ -287,9 +365,43 @@ public:
 	IPakFile* GetPakFile() const { return Status >= EGFPakLoaderStatus::Mounted ? MountedPakFile : nullptr; }
 	/**
 	 * Returns the PluginAsset Registry
-	 * Only Valid if Status is >= `Mounted`
+	 * Only Valid if Status is >= `Mounted`, and null if UGFPakLoaderSettings::bKeepPluginAssetRegistryInMemory is false
 	 */
 	const FAssetRegistryState* GetPluginAssetRegistry() const { return Status >= EGFPakLoaderStatus::Mounted ? PluginAssetRegistry.GetPtrOrNull() : nullptr; }
+	/**
+	 * Returns true if the given package is part of this Pak Plugin.
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	bool ContainsPackage(const FName PackageName) const;
+	/**
+	 * Returns true if the given asset is part of this Pak Plugin.
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	bool ContainsAsset(const FSoftObjectPath& AssetPath) const;
+	/**
+	 * Returns the FAssetData of the given asset as packaged in this Pak Plugin, which is not the one in the global Asset Registry if another source overrides the asset.
+	 * Only Valid if Status is >= `Mounted`
+	 * @return Returns false if the asset is not part of this Pak Plugin
+	 */
+	bool GetPluginAssetData(const FSoftObjectPath& AssetPath, FAssetData& OutAssetData) const;
+	/**
+	 * Returns true if one of the loaded packages of this Pak Plugin is rooted or referenced from outside of the Pak Plugin, so unmounting it would unload content still in use.
+	 * The GameFeatureData and the assets preloaded by the Pak Plugin are not considered, as they are released by unmounting it.
+	 * The referencers are found by going through all the UObjects, so this should not be called every frame. See UGFPakLoaderSubsystem::EvictLeastRecentlyUsedPakPlugins
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	bool IsContentInUse() const;
+	/**
+	 * Same as IsContentInUse for multiple PakPlugins, going through all the UObjects only once.
+	 * The content of a PakPlugin referenced by another one of the given PakPlugins is in use, as the other one might not be unmounted.
+	 * @return For each PakPlugin, true if its content is in use
+	 */
+	static TArray<bool> IsContentInUse(TConstArrayView<const UGFPakPlugin*> PakPlugins);
+	/**
+	 * Returns the size on disk of the loaded packages of this Pak Plugin, as an estimate of the memory used by its content. See UGFPakLoaderSettings::PakPluginsMemoryBudget
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	int64 GetLoadedPackagesSize() const;
 	/**
 		 * Returns the PluginAsset Registry
 		 * Only Valid if Status is >= `Mounted`
@@ -297,26 +409,52 @@ public:
 	const TSharedPtr<IPlugin>& GetPluginInterface() const { return PluginInterface; }
 	
 	/**
-	 * Returns the FAssetData pointing to the UGameFeatureData of this GFPakPlugin.
+	 * Returns the FAssetData pointing to the UGameFeatureData of this GFPakPlugin. It is resolved once when mounting.
 	 * Only Valid if Status is >= `Mounted` and if the plugin is a GameFeatures plugin.
 	 */
-	const FAssetData* GetGameFeatureData() const;
+	const FAssetData* GetGameFeatureData() const { return GameFeatureData; }
 	
 	/**
 	 * Return a map of the possible filenames of files present within this pak. Useful to check if a file exists.
 	 * The Key is the possible name to look for, and the value, which can be shared between multiple entries, is a
 	 * FGFPakFilenameMap containing possible derivation of the filename.
-	 * Only Valid if Status is >= `Mounted`
+	 * Only Valid if Status is >= `Mounted`. Only safe to use on the Game Thread, use FindPakFilename from other threads.
 	 * @return 
 	 */
 	const TMap<FName, TSharedPtr<const FGFPakFilenameMap>>& GetPakFilenamesMap() const { return PakFilenamesMap;};
+	/**
+	 * Returns the FGFPakFilenameMap of the given filename if the file is present within this pak, otherwise null. Safe to call from any thread.
+	 * Only Valid if Status is >= `Mounted`
+	 */
+	TSharedPtr<const FGFPakFilenameMap> FindPakFilename(FName Filename) const;
 protected:
 	EGFPakLoaderStatus PreviouslyBroadcastedStatus = EGFPakLoaderStatus::NotInitialized;
 	bool BroadcastOnStatusChange(EGFPakLoaderStatus NewStatus);
+	/** Changes the Status without broadcasting it. All the changes of Status need to go through here so the UGFPakLoaderSubsystem status buckets stay up to date */
+	void SetStatus(EGFPakLoaderStatus NewStatus);
+	/** Sets the Status for the duration of the scope without broadcasting it, the equivalent of a TGuardValue going through SetStatus */
+	struct FTemporaryStatus
+	{
+		FTemporaryStatus(UGFPakPlugin& InPakPlugin, EGFPakLoaderStatus TemporaryStatus)
+			: PakPlugin(InPakPlugin)
+			, PreviousStatus(InPakPlugin.Status)
+		{
+			PakPlugin.SetStatus(TemporaryStatus);
+		}
+		~FTemporaryStatus()
+		{
+			PakPlugin.SetStatus(PreviousStatus);
+		}
+	private:
+		UGFPakPlugin& PakPlugin;
+		EGFPakLoaderStatus PreviousStatus;
+	};
 private:
 	bool IsValidPakPluginDirectory(const FString& InPakPluginDirectory);
 
 	inline static const FString PaksFolderFromDirectory = TEXT("Content/Paks");
+	friend FGFPakPluginDirectoryInfo;
+	friend UGFPakLoaderSubsystem; // Resets the ClassAssetsCache when the overrides of the plugin assets change
 	inline static const TArray<const FAssetData*> EmptyAssetsData = {};
 private:
 	/** Returns the path to the Pak Plugin Directory this struct points to, for example 'C:/Pak/my-plugin-name/' */
@@ -351,6 +489,20 @@ private:
 	 * Only Valid if Status is >= `Unmounted`
 	 */
 	FPluginDescriptor PluginDescriptor;
+	/**
+	 * True if the .uplugin of this Pak Plugin sets ExplicitlyLoaded to true. If not, a copy setting it is registered with the Plugin Manager instead. See GetRegisteredUPluginPath
+	 * Only Valid if Status is >= `Unmounted`
+	 */
+	bool bIsUPluginExplicitlyLoaded = false;
+	/**
+	 * The initial GameFeature state of this Pak Plugin, resolved when loading the .uplugin and used to auto activate the GameFeature when mounting.
+	 * Only Valid if Status is >= `Unmounted`
+	 */
+	EBuiltInAutoState BuiltInInitialFeatureState{};
+
+	/** The priority of this Pak Plugin, used when multiple Pak Plugins contain the same asset. See GetPakPriority */
+	UPROPERTY(BlueprintReadOnly, Category="GameFeatures Pak Loader", meta = (AllowPrivateAccess = "true"))
+	int32 PakPriority = 0;
 
 	/** Returns the current status of this Pak Plugin */
 	UPROPERTY(Transient, BlueprintReadOnly, Category="GameFeatures Pak Loader", meta = (AllowPrivateAccess = "true"))
@@ -380,14 +532,86 @@ private:
 	FPluginEvent OnDestroyedDelegate;
 
 	TOptional<FAssetRegistryState> PluginAssetRegistry;
+	/** The path of the AssetRegistry.bin within the pak, used to reload the PluginAssetRegistry when it is not kept in memory */
+	FString PluginAssetRegistryPath;
+	/** See GetMountReadBytes */
+	int64 MountReadBytes = 0;
+	
+	/**
+	 * Lightweight index of the plugin assets kept instead of the PluginAssetRegistry when UGFPakLoaderSettings::bKeepPluginAssetRegistryInMemory is false.
+	 * The FAssetData are retrieved from the global Asset Registry when needed.
+	 */
+	struct FPluginAssetsIndex
+	{
+		TSet<FName> PackageNames;
+		TSet<FSoftObjectPath> AssetPaths;
+		TMap<FTopLevelAssetPath, TArray<FSoftObjectPath>> AssetsByClass;
+		TOptional<FAssetData> GameFeatureData;
+	};
+	TOptional<FPluginAssetsIndex> PluginAssetsIndex;
+	/** The FAssetData of the UGameFeatureData of this plugin, resolved in Mount_Internal and pointing to the PluginAssetRegistry or the PluginAssetsIndex */
+	const FAssetData* GameFeatureData = nullptr;
+	/** The Content folders packaged in the pak, kept to be given to the Remount Cache when unmounting. See UGFPakLoaderSettings::RemountCacheSize */
+	TArray<FString> PakContentFolders;
+	
+	/** The assets of a class returned by GetPluginAssetsOfClass */
+	struct FClassAssetsCache
+	{
+		TArray<FAssetData> AssetsData; // Only used when the assets are retrieved from the global Asset Registry
+		TArray<const FAssetData*> Assets;
+		TArray<const FAssetData*> AssetsWithoutCookGenerated;
+	};
+	TMap<FTopLevelAssetPath, TUniquePtr<FClassAssetsCache>> ClassAssetsCache;
+	
+	/** The handles of the assets loaded in the background after mounting. See UGFPakLoaderSettings::bPreloadGameFeatureAssets */
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+	/** Starts loading the UGameFeatureData asynchronously, followed by the primary assets it declares */
+	void PreloadGameFeatureAssets();
+	void PreloadPrimaryAssets();
+	void ReleasePreloadHandles();
 
 	bool bNeedGameFeatureUnloading = false;
+	/** Set when mounted instead of activating the GameFeature. Atomic as the files are opened from any thread. See NotifyContentAccessed */
+	std::atomic<bool> bWaitingForFirstAccess = false;
+	/** Updated by NotifyContentAccessed, used to order the Pak Plugins to unmount, least recently used first. See UGFPakLoaderSettings::MaxMountedPakPlugins */
+	std::atomic<double> LastAccessTime = 0.0;
 	TArray<FOperationCompleted> AdditionalActivationDelegate;
 	TArray<FOperationCompleted> AdditionalDeactivationDelegate;
 
 	TSharedPtr<IPlugin> PluginInterface = nullptr;
 	
+	/** Guards the writes to the PakFilenamesMap on the Game Thread against FindPakFilename, called from any thread by UGFPakLoaderSubsystem::FindMountedPakContainingFile */
+	mutable FRWLock PakFilenamesMapLock;
 	TMap<FName, TSharedPtr<const FGFPakFilenameMap>> PakFilenamesMap;
+	/** Set while the Asset Registry scans the files of the plugin being unmounted, so FindPakFilename reports them as missing without changing the PakFilenamesMap */
+	std::atomic<bool> bPakFilenamesHidden = false;
+	/** Replaces the PakFilenamesMap under the PakFilenamesMapLock and returns the previous one */
+	TMap<FName, TSharedPtr<const FGFPakFilenameMap>> ExchangePakFilenamesMap(TMap<FName, TSharedPtr<const FGFPakFilenameMap>>&& NewPakFilenamesMap);
+	
+	/** The cached data of the pak registered without being mounted, used instead of reading them from the pak when mounting. See UGFPakLoaderSettings::bMountPakPluginsOnDemand */
+	struct FOnDemandRegistration
+	{
+		FString AssetRegistryPath;
+		TArray<FString> ContentFolders;
+		FAssetRegistryState AssetRegistryState;
+		// Kept alive until the pak is mounted, which then reuses them
+		TArray<TSharedPtr<FPluginMountPoint>> MountPoints;
+	};
+	TOptional<FOnDemandRegistration> OnDemandRegistration;
+	/** Returns the folder of the cached data of this Pak Plugin, ex: 'Saved/GFPakLoader/OnDemand/<plugin-name>/' */
+	FString GetOnDemandCacheFolder() const;
+	/** Copies the Asset Registry of the mounted pak and saves the data needed to register it without mounting */
+	void SaveOnDemandCache() const;
+	/**
+	 * Returns the path of the .uplugin registered with the Plugin Manager and the GameFeatures Subsystem.
+	 * This is the .uplugin of the Pak Plugin, unless it is not ExplicitlyLoaded, in which case it is the generated copy 'Saved/GFPakLoader/Descriptors/<plugin-name>/<plugin-name>.uplugin'
+	 */
+	FString GetRegisteredUPluginPath() const;
+	/**
+	 * Writes the copy of the .uplugin setting ExplicitlyLoaded to true, as the Plugin Manager only mounts ExplicitlyLoaded plugins and the .uplugin next to the pak is never modified.
+	 * @return true if the copy was written
+	 */
+	bool WriteExplicitlyLoadedUPlugin(FText& OutFailReason) const;
 private:
 
 	// Internal functions that do all the work but do not broadcast the change of Status
@@ -398,6 +622,19 @@ private:
 	void UnloadPakPluginObjects_Internal(const FOperationCompleted& CompleteDelegate);
 	bool Unmount_Internal();
 	void Deinitialize_Internal();
+	/** Registers the Pak Plugin from its cache without mounting its pak. Returns false if the cache is missing or outdated */
+	bool RegisterOnDemand_Internal();
+	/** Removes from the Asset Registry the assets added by RegisterOnDemand_Internal, if the pak was not mounted since */
+	void UnregisterOnDemand_Internal();
+
+	/** Finds the UGameFeatureData at the root of the plugin Content directory in the PluginAssetRegistry */
+	const FAssetData* FindGameFeatureData() const;
+	/** Builds the PluginAssetsIndex from the PluginAssetRegistry */
+	void BuildPluginAssetsIndex();
+	/** Calls the Callback for each package of this Pak Plugin currently loaded in memory */
+	void ForEachLoadedPackage(TFunctionRef<void(UPackage* Package)> Callback) const;
+	/** Retrieves the FAssetData of the given plugin assets without the PluginAssetRegistry. See GetPluginAssetData */
+	void GetAssetsFromAssetRegistry(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetData>& OutAssets, bool bIncludeCookGeneratedAssets) const;
 
 	static void PurgePakPluginContent(const FString& PakPluginName, const TFunctionRef<bool(UObject*)>& ShouldObjectBePurged, bool bMarkAsGarbage = true);
 	/** Returns true if the object and its children were purged, otherwise false */
@@ -469,6 +706,8 @@ private:
 	 */
 	static void AddOrRemovePackagesFromAssetRegistryEmptyPackagesCache(EAddOrRemove Action, const TSet<FName>& PackageNames);
 
+	/** Adds the assets of the given Plugin Asset Registry to the global Asset Registry, keeping track of the assets they override */
+	void AddPluginAssetsToAssetRegistry(const FAssetRegistryState& AssetRegistryState);
 	void UnregisterPluginAssetsFromAssetRegistry();
 
 #if WITH_EDITOR
@@ -477,5 +716,7 @@ public:
 private:
 	// Set just before creating a MountPoint for the ContentBrowser to refer to. Ex: {"/DLCTestProject/", "/../../../DLCTestProject/Content/"}
 	TPair<FString, FString> MountPointAboutToBeMounted;
+	/** Sets MountPointAboutToBeMounted and keeps the index of the UGFPakLoaderSubsystem up to date */
+	void SetMountPointAboutToBeMounted(TPair<FString, FString>&& InMountPointAboutToBeMounted);
 #endif
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "GFPakLoaderSubsystem.h"
 #include "GFPakPlugin.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "GFPakPluginAsyncBPFunctions.generated.h"
@@ -11,6 +12,7 @@
 class UGFPakPlugin;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPakPluginAsyncEvent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPakPluginsBatchAsyncEvent, const TArray<FGFPakPluginOperationResult>&, Results, double, TotalSeconds);
 
 /**
  * Class to call the Async UGFPakPlugin::ActivateGameFeature from Blueprints
@@ -93,3 +95,106 @@ private:
 	void ReportDeactivated();
 	void ReportFailed();
 };
+
+
+/**
+ * Class to call the Async UGFPakLoaderSubsystem::ActivateGameFeatures from Blueprints
+ */
+UCLASS()
+class GFPAKLOADER_API UGFPakPluginsActivateGameFeaturesAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Activate the GameFeatures of all these Pak Plugins. This function is Asynchronous and the callbacks will be called once all the activations are completed.
+	 * The independent Pak Plugins are activated concurrently, and each Pak Plugin is only activated once the Pak Plugins it depends on are activated.
+	 * @param GFPakPlugins The Pak Plugins to activate
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Activate Game Features", Category="GameFeatures Pak Loader", meta=(BlueprintInternalUseOnly="true"))
+	static UGFPakPluginsActivateGameFeaturesAsync* GFPakPluginsActivateGameFeaturesAsync(UPARAM(DisplayName = "Pak Plugins") const TArray<UGFPakPlugin*>& GFPakPlugins);
+
+	/** Called when all the Pak Plugins successfully activated their GameFeatures, with the result of each Pak Plugin */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginsBatchAsyncEvent OnActivated;
+
+	/** Called when at least one of the Pak Plugins failed activating its GameFeatures, with the result of each Pak Plugin */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginsBatchAsyncEvent OnFailed;
+
+	// Start UBlueprintAsyncActionBase Functions
+	virtual void Activate() override;
+	// End UBlueprintAsyncActionBase Functions
+private:
+	UPROPERTY()
+	TArray<UGFPakPlugin*> PakPlugins;
+};
+
+
+/**
+ * Class to call the Async UGFPakLoaderSubsystem::DeactivateGameFeatures from Blueprints
+ */
+UCLASS()
+class GFPAKLOADER_API UGFPakPluginsDeactivateGameFeaturesAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Deactivate the GameFeatures of all these Pak Plugins concurrently. This function is Asynchronous and the callbacks will be called once all the deactivations are completed.
+	 * @param GFPakPlugins The Pak Plugins to deactivate
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Deactivate Game Features", Category="GameFeatures Pak Loader", meta=(BlueprintInternalUseOnly="true"))
+	static UGFPakPluginsDeactivateGameFeaturesAsync* GFPakPluginsDeactivateGameFeaturesAsync(UPARAM(DisplayName = "Pak Plugins") const TArray<UGFPakPlugin*>& GFPakPlugins);
+
+	/** Called when all the Pak Plugins successfully deactivated their GameFeatures, with the result of each Pak Plugin */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginsBatchAsyncEvent OnDeactivated;
+
+	/** Called when at least one of the Pak Plugins failed deactivating its GameFeatures, with the result of each Pak Plugin */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginsBatchAsyncEvent OnFailed;
+
+	// Start UBlueprintAsyncActionBase Functions
+	virtual void Activate() override;
+	// End UBlueprintAsyncActionBase Functions
+private:
+	UPROPERTY()
+	TArray<UGFPakPlugin*> PakPlugins;
+};
+
+
+/**
+ * Class to call the Async UGFPakLoaderSubsystem::ScheduleMount from Blueprints
+ */
+UCLASS()
+class GFPAKLOADER_API UGFPakPluginScheduleMountAsync : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Schedule the mounting of this Pak Plugin with the given priority. This function is Asynchronous and the callbacks will be called once the Pak Plugin is mounted or failed to mount.
+	 * @param GFPakPlugin The Pak Plugin to mount
+	 * @param MountPriority The priority of the mount, see EGFPakMountPriority
+	 * @param OutGFPakPlugin Just returns the Pak Plugin that was passed in
+	 */
+	UFUNCTION(BlueprintCallable, DisplayName="Schedule Mount", Category="GameFeatures Pak Loader", meta=(BlueprintInternalUseOnly="true"))
+	static UGFPakPluginScheduleMountAsync* GFPakPluginScheduleMountAsync(UPARAM(DisplayName = "Pak Plugin") UGFPakPlugin* GFPakPlugin, UPARAM(DisplayName = "Priority") EGFPakMountPriority MountPriority, UPARAM(DisplayName = "GF Pak Plugin") UGFPakPlugin*& OutGFPakPlugin);
+
+	/** Called when the Pak Plugin is mounted */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginAsyncEvent OnMounted;
+
+	/** Called when the Pak Plugin failed to mount */
+	UPROPERTY(BlueprintAssignable)
+	FPakPluginAsyncEvent OnFailed;
+
+	// Start UBlueprintAsyncActionBase Functions
+	virtual void Activate() override;
+	// End UBlueprintAsyncActionBase Functions
+private:
+	UPROPERTY()
+	UGFPakPlugin* PakPlugin = nullptr;
+	EGFPakMountPriority Priority = EGFPakMountPriority::Normal;
+};
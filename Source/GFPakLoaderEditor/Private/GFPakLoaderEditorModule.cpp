@@ -39,57 +39,16 @@ void FGFPakLoaderEditorModule::OnContentBrowserGenerateVirtualPathPrefix(const F
 	UGFPakLoaderSubsystem* Subsystem = UGFPakLoaderSubsystem::Get();
 	if (IsValid(Subsystem)  && Subsystem->IsReady())
 	{
-		auto AppendPrefix = [&](const UGFPakPlugin* Plugin)
+		//todo: Minor bug, when a Plugin with the same name as a Pak plugin exists, this will end up showing the Plugin content in the PakPlugins folder, even though the PakPlugin will not be able to Mount
+		// This should be fixed with a "Mounting" state
+		const TCHAR* DebugReason = TEXT("");
+		if (const UGFPakPlugin* Plugin = Subsystem->FindPakPluginByMountPointName(MountPointStringView, &DebugReason))
 		{
 			// Give a special virtual Path if the content is from a Pak Plugin : '/All/PakPlugins/<PluginName>/<MountPoint>/...'
 			OutPath.Append(GFPakLoaderVirtualPathPrefix);
 			OutPath.Append("/");
 			OutPath.Append(Plugin->GetPluginName());
-		};
-
-		UGFPakPlugin* Plugin = nullptr;
-		FString DebugReason;
-		Subsystem->EnumeratePakPluginsWithStatus<UGFPakLoaderSubsystem::EComparison::GreaterOrEqual>(EGFPakLoaderStatus::Unmounted, [&MountPointStringView, &Plugin, &DebugReason](UGFPakPlugin* PakPlugin)
-		{
-			// The main issue here is that some callbacks are triggered before the MountPoints are added to the plugin,
-			// so the plugin currently has to force the content browser to refresh
-			if (PakPlugin->GetStatus() == EGFPakLoaderStatus::Unmounted) 
-			{
-				//todo: Minor bug, when a Plugin with the same name as a Pak plugin exists, this will end up showing the Plugin content in the PakPlugins folder, even though the PakPlugin will not be able to Mount
-				// This should be fixed with a "Mounting" state
-				const FStringView PluginMountPointView = FPathViews::GetMountPointNameFromPath(PakPlugin->GetMountPointAboutToBeMounted().Key);
-				if (PluginMountPointView == MountPointStringView)
-				{
-					Plugin = PakPlugin;
-					DebugReason = "MountPointAboutToBeMounted";
-					return UGFPakLoaderSubsystem::EForEachResult::Break;
-				}
-			}
-			
-			if (PakPlugin->GetPluginName() == MountPointStringView)
-			{
-				Plugin = PakPlugin;
-				DebugReason = "PLUGIN NAME";
-				return UGFPakLoaderSubsystem::EForEachResult::Break;
-			}
-			
-			for (const TSharedPtr<FPluginMountPoint>& PluginMountPoint : PakPlugin->GetPakPluginMountPoints())
-			{
-				const FStringView PluginMountPointView = FPathViews::GetMountPointNameFromPath(PluginMountPoint->GetRootPath());
-				if (PluginMountPoint->IsRegistered() && PluginMountPointView == MountPointStringView)
-				{
-					Plugin = PakPlugin;
-					DebugReason = "REGISTERED MOUNT POINT";
-					return UGFPakLoaderSubsystem::EForEachResult::Break;
-				}
-			}
-			return UGFPakLoaderSubsystem::EForEachResult::Continue;
-		});
-
-		if (Plugin)
-		{
-			AppendPrefix(Plugin);
-            UE_LOG(LogGFPakLoaderEditor, VeryVerbose, TEXT(" OnContentBrowserGenerateVirtualPathPrefix:  Path  '%s' => Virtual Path  '%s'  as it is matching the %s"), *FString{InPath}, *OutPath, *DebugReason);
+			UE_LOG(LogGFPakLoaderEditor, VeryVerbose, TEXT(" OnContentBrowserGenerateVirtualPathPrefix:  Path  '%s' => Virtual Path  '%s'  as it is matching the %s"), *FString{InPath}, *OutPath, DebugReason);
 			return;
 		}
 	}